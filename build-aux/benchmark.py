@@ -0,0 +1,323 @@
+#!/usr/bin/env python
+# Copyright (C) 2026 agent <agent@local>
+#
+# This file is part of predator.
+#
+# predator is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# any later version.
+#
+# predator is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with predator.  If not, see <http://www.gnu.org/licenses/>.
+
+"""
+Run the programs listed in tests/benchmark.list by Predator and Forester, store
+the measured numbers as JSON and compare them with a baseline (if given).
+
+The numbers measured for each program are the wall time taken by gcc [s], the
+exit status of gcc and everything the analyzer prints on the line started by
+'analysis statistics:' (requested by the print_stats option of Predator and
+by the print-stats option of Forester), e.g. peak_rss [MiB], heaps, paths,
+join_hits or call_hits.  The join_hit_rate and call_hit_rate are computed
+from the counters.
+
+A metric is reported as a regression if it grows by more than its tolerance,
+relative to the baseline (or drops in case of the hit rates).  The script
+exits with non-zero status if any regression is found.
+"""
+
+from __future__ import print_function
+
+import json
+import optparse
+import os
+import re
+import subprocess
+import sys
+import time
+
+TOPDIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+# how to run each of the tools: (plug-in, -D flag, -fplugin-arg-*-args)
+TOOLS = {
+    "predator": ("sl", "PREDATOR", "error_label:ERROR,print_stats"),
+    "forester": ("fa", "FORESTER", "print-stats"),
+}
+
+# tolerances used unless overridden by the -t option (relative to baseline)
+TOLERANCES = {
+    "default":  0.05,
+    "peak_rss": 0.10,
+    "time":     0.25,
+}
+
+# differences in the wall time below this amount [s] are considered noise
+TIME_NOISE = 0.1
+
+# metrics where the lower value is the worse one
+HIGHER_IS_BETTER = ("call_hit_rate", "call_hits", "join_hit_rate", "join_hits")
+
+# metrics computed from the counters: (name, hits, lookups)
+RATES = (
+    ("call_hit_rate", "call_hits", "call_lookups"),
+    ("join_hit_rate", "join_hits", "join_tries"),
+)
+
+# metrics where we take the minimum over repeated runs
+NOISY = ("peak_rss", "time")
+
+STATS_RE = re.compile(r"analysis statistics: (.*)$", re.M)
+ITEM_RE = re.compile(r"([a-z][a-z-]*) ([0-9]+)")
+
+
+def die(msg):
+    sys.stderr.write("%s: %s\n" % (os.path.basename(sys.argv[0]), msg))
+    sys.exit(1)
+
+
+def find_gcc():
+    gcc = os.environ.get("GCC_HOST")
+    if gcc:
+        return gcc
+
+    # the same fallback as in build-aux/xgcclib.sh
+    gcc = os.path.join(TOPDIR, "gcc-install", "bin", "gcc")
+    if os.access(gcc, os.X_OK):
+        return gcc
+
+    return "gcc"
+
+
+def read_suite(fileName, tools):
+    suite = []
+    for line in open(fileName):
+        line = line.split("#", 1)[0].split()
+        if not line:
+            continue
+
+        tool = line[0]
+        if tool not in TOOLS:
+            die("%s: unknown tool '%s'" % (fileName, tool))
+
+        if tools and tool not in tools:
+            continue
+
+        path = os.path.join(TOPDIR, "tests", line[1])
+        if not os.path.isfile(path):
+            die("%s: program not found: %s" % (fileName, path))
+
+        suite.append((tool, line[1], line[2:]))
+
+    return suite
+
+
+def parse_stats(output):
+    stats = {}
+    matches = STATS_RE.findall(output)
+    if not matches:
+        return stats
+
+    for name, value in ITEM_RE.findall(matches[-1]):
+        stats[name.replace("-", "_")] = int(value)
+
+    for name, hits, lookups in RATES:
+        if stats.get(lookups):
+            stats[name] = round(stats[hits] / float(stats[lookups]), 4)
+
+    return stats
+
+
+def run_one(opts, tool, prog, flags):
+    plug, define, args = TOOLS[tool]
+    path = os.path.join(TOPDIR, "tests", prog)
+    cmd = [opts.gcc, "-S", "-o", os.devnull, "-O0",
+           "-I%s/include/%s-builtins" % (TOPDIR, tool), "-D" + define,
+           "-fplugin=%s/%s_build/lib%s.so" % (TOPDIR, plug, plug),
+           "-fplugin-arg-lib%s-args=%s" % (plug, args),
+           "-fplugin-arg-lib%s-preserve-ec" % plug]
+    cmd += flags + [os.path.basename(path)]
+    if opts.timeout:
+        cmd = ["timeout", str(opts.timeout)] + cmd
+
+    env = dict(os.environ)
+    env["LC_ALL"] = "C"
+    env["CCACHE_DISABLE"] = "1"
+
+    result = None
+    for _ in range(opts.repeat):
+        start = time.time()
+        proc = subprocess.Popen(cmd, cwd=os.path.dirname(path), env=env,
+                                stdout=subprocess.PIPE,
+                                stderr=subprocess.STDOUT,
+                                universal_newlines=True)
+        output = proc.communicate()[0]
+
+        run = parse_stats(output)
+        run["time"] = round(time.time() - start, 3)
+        run["status"] = proc.returncode
+        if result is None:
+            result = run
+            continue
+
+        # the counters do not change among runs, the measured amounts do
+        for name in NOISY:
+            if name in run:
+                result[name] = min(result.get(name, run[name]), run[name])
+
+    return result
+
+
+def relative_change(base, cur):
+    if base == cur:
+        return 0.0
+
+    if not base:
+        return float("inf") if base < cur else float("-inf")
+
+    return (cur - base) / float(abs(base))
+
+
+def compare_one(key, base, cur, tolerances):
+    regressions = []
+    improvements = []
+
+    if base.get("status") != cur.get("status"):
+        regressions.append("%s: exit status changed from %s to %s"
+                           % (key, base.get("status"), cur.get("status")))
+
+    for name in sorted(set(base) & set(cur)):
+        if "status" == name:
+            continue
+
+        b = base[name]
+        c = cur[name]
+        if "time" == name and abs(c - b) < TIME_NOISE:
+            continue
+
+        change = relative_change(b, c)
+        msg = "%s: %s %s -> %s (%+.1f%%)" % (key, name, b, c, 100.0 * change)
+        if name in HIGHER_IS_BETTER:
+            change = -change
+
+        tol = tolerances.get(name, tolerances["default"])
+        if tol < change:
+            regressions.append(msg)
+        elif change < -tol:
+            improvements.append(msg)
+
+    return regressions, improvements
+
+
+def compare(baseline, results, tolerances):
+    regressions = []
+    improvements = []
+    for key in sorted(results):
+        if key not in baseline:
+            print("new in the suite: %s" % key)
+            continue
+
+        r, i = compare_one(key, baseline[key], results[key], tolerances)
+        regressions += r
+        improvements += i
+
+    for key in sorted(set(baseline) - set(results)):
+        print("missing in the results: %s" % key)
+
+    for msg in improvements:
+        print("improvement: " + msg)
+
+    for msg in regressions:
+        print("REGRESSION: " + msg)
+
+    return not regressions
+
+
+def parse_tolerances(items):
+    tolerances = dict(TOLERANCES)
+    for item in items:
+        name, sep, value = item.partition("=")
+        try:
+            tolerances[name] = float(value)
+        except ValueError:
+            die("invalid tolerance '%s', use METRIC=TOL" % item)
+
+    return tolerances
+
+
+def main():
+    parser = optparse.OptionParser(usage="%prog [options]")
+    parser.add_option("-s", "--suite", metavar="FILE",
+                      default=os.path.join(TOPDIR, "tests", "benchmark.list"),
+                      help="list of programs to run [%default]")
+    parser.add_option("-o", "--output", metavar="FILE",
+                      help="write the results as JSON to FILE")
+    parser.add_option("-b", "--baseline", metavar="FILE",
+                      help="compare the results with FILE (if it exists)")
+    parser.add_option("-t", "--tolerance", metavar="METRIC=TOL",
+                      action="append", default=[],
+                      help="relative tolerance of METRIC, 'default' applies "
+                      "to the metrics not listed explicitly (defaults: %s)"
+                      % ", ".join("%s=%s" % item
+                                  for item in sorted(TOLERANCES.items())))
+    parser.add_option("-r", "--repeat", metavar="N", type="int", default=1,
+                      help="run each program N times and take the minimum of "
+                      "the time and memory usage [%default]")
+    parser.add_option("-T", "--timeout", metavar="SECONDS", type="int",
+                      default=300, help="time limit per run, 0 means no "
+                      "limit [%default]")
+    parser.add_option("--tool", action="append", default=[],
+                      choices=sorted(TOOLS), help="run only the given tool")
+    opts, args = parser.parse_args()
+    if args or opts.repeat < 1:
+        parser.error("invalid arguments")
+
+    tolerances = parse_tolerances(opts.tolerance)
+    opts.gcc = find_gcc()
+
+    for tool in opts.tool or TOOLS:
+        plug = TOOLS[tool][0]
+        path = "%s/%s_build/lib%s.so" % (TOPDIR, plug, plug)
+        if not os.path.isfile(path):
+            die("%s GCC plug-in not found: %s" % (tool, path))
+
+    results = {}
+    for tool, prog, flags in read_suite(opts.suite, opts.tool):
+        key = "%s:%s" % (tool, prog)
+        result = run_one(opts, tool, prog, flags)
+        results[key] = result
+        print("%-56s %8.3f s %6s MiB  status %s" % (key, result["time"],
+              result.get("peak_rss", "?"), result["status"]))
+        sys.stdout.flush()
+
+    if opts.output:
+        data = {"gcc": opts.gcc, "results": results}
+        with open(opts.output, "w") as out:
+            json.dump(data, out, indent=2, sort_keys=True)
+            out.write("\n")
+
+    if not opts.baseline:
+        return 0
+
+    if not os.path.isfile(opts.baseline):
+        print("baseline %s not found, nothing to compare with" % opts.baseline)
+        return 0
+
+    with open(opts.baseline) as inp:
+        baseline = json.load(inp)["results"]
+
+    if opts.tool:
+        # compare only the results of the tools we have run
+        baseline = dict((key, value) for key, value in baseline.items()
+                        if key.split(":", 1)[0] in opts.tool)
+
+    return 0 if compare(baseline, results, tolerances) else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
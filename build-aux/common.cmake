@@ -126,6 +126,10 @@ endif()
 
 option(TEST_WITH_VALGRIND "Set to ON to enable valgrind tests" OFF)
 
+# needed by CL_PREPROCESS_THREADS and CL_PLOT_WRITER_QUEUE in config_cl.h
+set(THREADS_PREFER_PTHREAD_FLAG ON)
+find_package(Threads REQUIRED)
+
 # link PLUGIN_NAME with Code Listener build located in LIBCL_PATH
 macro(CL_LINK_GCC_PLUGIN PLUGIN_NAME LIBCL_PATH)
     if("${LIBCL_PATH}" STREQUAL "")
@@ -137,7 +141,8 @@ macro(CL_LINK_GCC_PLUGIN PLUGIN_NAME LIBCL_PATH)
     endif()
 
     # link the Code Listener static library
-    target_link_libraries(${PLUGIN_NAME} ${CLGCC_LIB} ${CL_LIB})
+    target_link_libraries(${PLUGIN_NAME} ${CLGCC_LIB} ${CL_LIB}
+        ${CMAKE_THREAD_LIBS_INIT})
 
     # this will recursively pull all needed symbols from the static libraries
     set_target_properties(${PLUGIN_NAME} PROPERTIES LINK_FLAGS -Wl,--entry=plugin_init)
@@ -156,3 +161,21 @@ macro(CL_BUILD_GCC_PLUGIN PLUGIN ANALYZER LIBCL_PATH)
     CL_LINK_GCC_PLUGIN(${PLUGIN} ${LIBCL_PATH})
     target_link_libraries(${PLUGIN} ${ANALYZER})
 endmacro()
+
+# build standalone runner RUNNER from static lib ANALYZER using CL from LIBCL_PATH
+macro(CL_BUILD_RUNNER RUNNER ANALYZER LIBCL_PATH)
+    if("${LIBCL_PATH}" STREQUAL "")
+        set(CLRUN_LIB clrun)
+        set(CL_RUN_LIB cl)
+    else()
+        find_library(CLRUN_LIB clrun PATHS ${LIBCL_PATH} NO_DEFAULT_PATH)
+        find_library(CL_RUN_LIB cl PATHS ${LIBCL_PATH} NO_DEFAULT_PATH)
+    endif()
+
+    # main() is pulled from libclrun.a, libcl.a and ANALYZER depend on each other
+    add_executable(${RUNNER} ${EMPTY_C_FILE})
+    target_link_libraries(${RUNNER}
+        ${CLRUN_LIB} ${CL_RUN_LIB} ${ANALYZER} ${CL_RUN_LIB}
+        ${CMAKE_THREAD_LIBS_INIT})
+    set_target_properties(${RUNNER} PROPERTIES LINKER_LANGUAGE CXX)
+endmacro()
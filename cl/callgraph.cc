@@ -24,7 +24,6 @@
 #include <cl/clutil.hh>
 #include <cl/storage.hh>
 
-#include "stopwatch.hh"
 #include "worklist.hh"
 
 #include <boost/foreach.hpp>
@@ -163,8 +162,6 @@ void buildTopList(Graph &cg)
 
 void buildCallGraph(const Storage &stor)
 {
-    StopWatch watch;
-
     BOOST_FOREACH(Fnc *fnc, stor.fncs)
         handleFnc(fnc);
 
@@ -178,8 +175,6 @@ void buildCallGraph(const Storage &stor)
 
     // construct topological order
     buildTopList(cg);
-
-    CL_DEBUG("buildCallGraph() took " << watch);
 }
 
 } // namespace CallGraph
@@ -0,0 +1,1121 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config_cl.h"
+#include "cl_binfile.hh"
+
+#include <cl/cl_msg.hh>
+
+#include "cl.hh"
+
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <boost/foreach.hpp>
+
+namespace {
+
+/// bump this whenever the layout of any record changes
+const unsigned long long BIN_FILE_VERSION = 1ULL;
+
+/// the file starts with this string (including the trailing zero)
+const char BIN_FILE_MAGIC[] = "predator-clbin";
+
+enum EBinTag {
+    BT_NONE = 0,
+
+    // definitions, referred by ID from the records that follow
+    BT_STRING,
+    BT_TYPE,
+    BT_VAR,
+
+    // call-backs of ICodeListener
+    BT_FILE_OPEN,
+    BT_FILE_CLOSE,
+    BT_FNC_OPEN,
+    BT_FNC_ARG_DECL,
+    BT_FNC_CLOSE,
+    BT_BB_OPEN,
+    BT_INSN,
+    BT_CALL_OPEN,
+    BT_CALL_ARG,
+    BT_CALL_CLOSE,
+    BT_SWITCH_OPEN,
+    BT_SWITCH_CASE,
+    BT_SWITCH_CLOSE,
+    BT_ACK
+};
+
+typedef std::string                                     TBuf;
+
+inline void putUInt(TBuf &buf, unsigned long long val)
+{
+    // variable-length quantity, 7 bits per byte, the least significant first
+    while (0x80 <= val) {
+        buf.push_back(static_cast<char>(0x80 | (val & 0x7F)));
+        val >>= 7;
+    }
+
+    buf.push_back(static_cast<char>(val));
+}
+
+inline void putInt(TBuf &buf, const long long val)
+{
+    // zig-zag encoding keeps small negative numbers short
+    const unsigned long long uval = static_cast<unsigned long long>(val);
+    putUInt(buf, (val < 0)
+            ? ~(uval << 1)
+            : (uval << 1));
+}
+
+inline void putBool(TBuf &buf, const bool val)
+{
+    buf.push_back(static_cast<char>(val));
+}
+
+inline void putReal(TBuf &buf, const double val)
+{
+    unsigned long long raw;
+    memcpy(&raw, &val, sizeof raw);
+    putUInt(buf, raw);
+}
+
+/// nullable reference to a type or a variable
+inline void putRef(TBuf &buf, const bool valid, const int uid)
+{
+    putBool(buf, valid);
+    if (valid)
+        putInt(buf, uid);
+}
+
+} // namespace
+
+// /////////////////////////////////////////////////////////////////////////////
+// ClBinWriter implementation
+class ClBinWriter: public ICodeListener {
+    public:
+        ClBinWriter(const char *fileName);
+        virtual ~ClBinWriter();
+
+        virtual void file_open(const char *fileName) {
+            this->putStr(ev_, fileName);
+            this->emit(BT_FILE_OPEN);
+        }
+
+        virtual void file_close() {
+            this->emit(BT_FILE_CLOSE);
+        }
+
+        virtual void fnc_open(const struct cl_operand *fnc) {
+            this->putOperand(ev_, fnc);
+            this->emit(BT_FNC_OPEN);
+        }
+
+        virtual void fnc_arg_decl(int argId, const struct cl_operand *argSrc) {
+            putInt(ev_, argId);
+            this->putOperand(ev_, argSrc);
+            this->emit(BT_FNC_ARG_DECL);
+        }
+
+        virtual void fnc_close() {
+            this->emit(BT_FNC_CLOSE);
+        }
+
+        virtual void bb_open(const char *label) {
+            this->putStr(ev_, label);
+            this->emit(BT_BB_OPEN);
+        }
+
+        virtual void insn(const struct cl_insn *cli) {
+            this->putInsn(ev_, cli);
+            this->emit(BT_INSN);
+        }
+
+        virtual void insn_call_open(
+            const struct cl_loc     *loc,
+            const struct cl_operand *dst,
+            const struct cl_operand *fnc)
+        {
+            this->putLoc(ev_, loc);
+            this->putOptOperand(ev_, dst);
+            this->putOptOperand(ev_, fnc);
+            this->emit(BT_CALL_OPEN);
+        }
+
+        virtual void insn_call_arg(int argId, const struct cl_operand *argSrc) {
+            putInt(ev_, argId);
+            this->putOptOperand(ev_, argSrc);
+            this->emit(BT_CALL_ARG);
+        }
+
+        virtual void insn_call_close() {
+            this->emit(BT_CALL_CLOSE);
+        }
+
+        virtual void insn_switch_open(
+            const struct cl_loc     *loc,
+            const struct cl_operand *src)
+        {
+            this->putLoc(ev_, loc);
+            this->putOptOperand(ev_, src);
+            this->emit(BT_SWITCH_OPEN);
+        }
+
+        virtual void insn_switch_case(
+            const struct cl_loc     *loc,
+            const struct cl_operand *valLo,
+            const struct cl_operand *valHi,
+            const char              *label)
+        {
+            this->putLoc(ev_, loc);
+            this->putOptOperand(ev_, valLo);
+            this->putOptOperand(ev_, valHi);
+            this->putStr(ev_, label);
+            this->emit(BT_SWITCH_CASE);
+        }
+
+        virtual void insn_switch_close() {
+            this->emit(BT_SWITCH_CLOSE);
+        }
+
+        virtual void acknowledge() {
+            this->emit(BT_ACK);
+            if (out_ && fflush(out_))
+                CL_ERROR("error while writing '" << fileName_ << "'");
+        }
+
+    private:
+        typedef std::map<std::string, unsigned long long>   TStrMap;
+
+        FILE                                   *out_;
+        std::string                             fileName_;
+        TBuf                                    ev_;
+        TStrMap                                 strMap_;
+        std::set<int>                           typeSeen_;
+        std::set<int>                           varSeen_;
+        std::vector<const struct cl_type *>     typeTodo_;
+        std::vector<const struct cl_var *>      varTodo_;
+
+        void write(const EBinTag tag, const TBuf &buf);
+        void emit(const EBinTag tag);
+
+        void putStr(TBuf &, const char *);
+        void putLoc(TBuf &, const struct cl_loc *);
+        void putType(TBuf &, const struct cl_type *);
+        void putVar(TBuf &, const struct cl_var *);
+        void putOperand(TBuf &, const struct cl_operand *);
+        void putOptOperand(TBuf &, const struct cl_operand *);
+        void putInsn(TBuf &, const struct cl_insn *);
+
+        void defineType(const struct cl_type *);
+        void defineVar(const struct cl_var *);
+};
+
+ClBinWriter::ClBinWriter(const char *fileName):
+    out_(fopen(fileName, "wb")),
+    fileName_(fileName)
+{
+    if (!out_) {
+        CL_ERROR("unable to create file '" << fileName << "'");
+        return;
+    }
+
+    CL_DEBUG("ClBinWriter: created binary file '" << fileName << "'");
+
+    TBuf hdr(BIN_FILE_MAGIC, sizeof BIN_FILE_MAGIC);
+    putUInt(hdr, BIN_FILE_VERSION);
+    fwrite(hdr.data(), 1, hdr.size(), out_);
+}
+
+ClBinWriter::~ClBinWriter()
+{
+    if (out_ && fclose(out_))
+        CL_ERROR("error while writing '" << fileName_ << "'");
+}
+
+void ClBinWriter::write(const EBinTag tag, const TBuf &buf)
+{
+    if (!out_)
+        return;
+
+    putc(tag, out_);
+    fwrite(buf.data(), 1, buf.size(), out_);
+}
+
+void ClBinWriter::emit(const EBinTag tag)
+{
+    // define all types and variables referred by the record being emitted
+    while (!typeTodo_.empty() || !varTodo_.empty()) {
+        if (!typeTodo_.empty()) {
+            const struct cl_type *clt = typeTodo_.back();
+            typeTodo_.pop_back();
+            this->defineType(clt);
+        }
+        else {
+            const struct cl_var *var = varTodo_.back();
+            varTodo_.pop_back();
+            this->defineVar(var);
+        }
+    }
+
+    this->write(tag, ev_);
+    ev_.clear();
+}
+
+void ClBinWriter::putStr(TBuf &buf, const char *str)
+{
+    if (!str) {
+        putUInt(buf, 0ULL);
+        return;
+    }
+
+    // strings are interned by their contents, IDs start with 1
+    const unsigned long long id = strMap_.size() + 1ULL;
+    std::pair<TStrMap::iterator, bool> ret =
+        strMap_.insert(TStrMap::value_type(str, id));
+
+    if (ret.second) {
+        // the string has no dependencies, define it right now
+        const size_t len = strlen(str) + /* trailing zero */ 1U;
+        TBuf def;
+        putUInt(def, len);
+        def.append(str, len);
+        this->write(BT_STRING, def);
+    }
+
+    putUInt(buf, ret.first->second);
+}
+
+void ClBinWriter::putLoc(TBuf &buf, const struct cl_loc *loc)
+{
+    if (!loc)
+        loc = &cl_loc_unknown;
+
+    this->putStr(buf, loc->file);
+    putInt(buf, loc->line);
+    putInt(buf, loc->column);
+    putBool(buf, loc->sysp);
+}
+
+void ClBinWriter::putType(TBuf &buf, const struct cl_type *clt)
+{
+    if (!clt) {
+        putRef(buf, false, 0);
+        return;
+    }
+
+    const int uid = clt->uid;
+    putRef(buf, true, uid);
+    if (typeSeen_.insert(uid).second)
+        typeTodo_.push_back(clt);
+}
+
+void ClBinWriter::putVar(TBuf &buf, const struct cl_var *var)
+{
+    if (!var) {
+        putRef(buf, false, 0);
+        return;
+    }
+
+    const int uid = var->uid;
+    putRef(buf, true, uid);
+    if (varSeen_.insert(uid).second)
+        varTodo_.push_back(var);
+}
+
+void ClBinWriter::putOperand(TBuf &buf, const struct cl_operand *op)
+{
+    const enum cl_operand_e code = op->code;
+    putUInt(buf, code);
+    if (CL_OPERAND_VOID == code)
+        return;
+
+    putUInt(buf, op->scope);
+    this->putType(buf, op->type);
+
+    // chain of accessors, terminated by false
+    for (const struct cl_accessor *ac = op->accessor; ac; ac = ac->next) {
+        putBool(buf, true);
+        putUInt(buf, ac->code);
+        this->putType(buf, ac->type);
+        switch (ac->code) {
+            case CL_ACCESSOR_DEREF_ARRAY:
+                this->putOptOperand(buf, ac->data.array.index);
+                break;
+
+            case CL_ACCESSOR_ITEM:
+                putInt(buf, ac->data.item.id);
+                break;
+
+            case CL_ACCESSOR_OFFSET:
+                putInt(buf, ac->data.offset.off);
+                break;
+
+            case CL_ACCESSOR_REF:
+            case CL_ACCESSOR_DEREF:
+                break;
+        }
+    }
+    putBool(buf, false);
+
+    if (CL_OPERAND_VAR == code) {
+        this->putVar(buf, op->data.var);
+        return;
+    }
+
+    const struct cl_cst &cst = op->data.cst;
+    putUInt(buf, cst.code);
+    switch (cst.code) {
+        case CL_TYPE_FNC:
+            putInt(buf, cst.data.cst_fnc.uid);
+            this->putStr(buf, cst.data.cst_fnc.name);
+            putBool(buf, cst.data.cst_fnc.is_extern);
+            this->putLoc(buf, &cst.data.cst_fnc.loc);
+            break;
+
+        case CL_TYPE_STRING:
+            this->putStr(buf, cst.data.cst_string.value);
+            break;
+
+        case CL_TYPE_REAL:
+            putReal(buf, cst.data.cst_real.value);
+            break;
+
+        default:
+            // the signedness is given by the type of the operand
+            putUInt(buf, cst.data.cst_uint.value);
+    }
+}
+
+void ClBinWriter::putOptOperand(TBuf &buf, const struct cl_operand *op)
+{
+    putBool(buf, !!op);
+    if (op)
+        this->putOperand(buf, op);
+}
+
+void ClBinWriter::putInsn(TBuf &buf, const struct cl_insn *cli)
+{
+    putUInt(buf, cli->code);
+    this->putLoc(buf, &cli->loc);
+
+    switch (cli->code) {
+        case CL_INSN_NOP:
+        case CL_INSN_ABORT:
+            break;
+
+        case CL_INSN_JMP:
+            this->putStr(buf, cli->data.insn_jmp.label);
+            break;
+
+        case CL_INSN_COND:
+            this->putOptOperand(buf, cli->data.insn_cond.src);
+            this->putStr(buf, cli->data.insn_cond.then_label);
+            this->putStr(buf, cli->data.insn_cond.else_label);
+            break;
+
+        case CL_INSN_RET:
+            this->putOptOperand(buf, cli->data.insn_ret.src);
+            break;
+
+        case CL_INSN_UNOP:
+            putUInt(buf, cli->data.insn_unop.code);
+            this->putOptOperand(buf, cli->data.insn_unop.dst);
+            this->putOptOperand(buf, cli->data.insn_unop.src);
+            break;
+
+        case CL_INSN_BINOP:
+            putUInt(buf, cli->data.insn_binop.code);
+            this->putOptOperand(buf, cli->data.insn_binop.dst);
+            this->putOptOperand(buf, cli->data.insn_binop.src1);
+            this->putOptOperand(buf, cli->data.insn_binop.src2);
+            break;
+
+        case CL_INSN_LABEL:
+            this->putStr(buf, cli->data.insn_label.name);
+            break;
+
+        case CL_INSN_CALL:
+        case CL_INSN_SWITCH:
+            // these are delivered by the dedicated call-backs
+            CL_TRAP;
+    }
+}
+
+void ClBinWriter::defineType(const struct cl_type *clt)
+{
+    TBuf def;
+    putInt(def, clt->uid);
+    putUInt(def, clt->code);
+    this->putLoc(def, &clt->loc);
+    putUInt(def, clt->scope);
+    this->putStr(def, clt->name);
+    putInt(def, clt->size);
+
+    const int cnt = clt->item_cnt;
+    putInt(def, cnt);
+    for (int i = 0; i < cnt; ++i) {
+        const struct cl_type_item &item = clt->items[i];
+        this->putType(def, item.type);
+        this->putStr(def, item.name);
+        putInt(def, item.offset);
+    }
+
+    putInt(def, clt->array_size);
+    putBool(def, clt->is_unsigned);
+    this->write(BT_TYPE, def);
+}
+
+void ClBinWriter::defineVar(const struct cl_var *var)
+{
+    // NOTE: the initializer is recorded as it is known when the variable is
+    // referred for the first time, which is also the time when it is read by
+    // ClStorageBuilder
+    TBuf def;
+    putInt(def, var->uid);
+    this->putStr(def, var->name);
+    putBool(def, var->artificial);
+    this->putLoc(def, &var->loc);
+    putBool(def, var->initialized);
+    putBool(def, var->is_extern);
+
+    for (const struct cl_initializer *in = var->initial; in; in = in->next) {
+        putBool(def, true);
+        this->putInsn(def, &in->insn);
+    }
+    putBool(def, false);
+
+    this->write(BT_VAR, def);
+}
+
+// /////////////////////////////////////////////////////////////////////////////
+// BinReader implementation
+class BinReader {
+    public:
+        BinReader():
+            map_(0),
+            size_(0),
+            cursor_(0),
+            end_(0),
+            ok_(true)
+        {
+        }
+
+        ~BinReader();
+
+        bool open(const char *fileName);
+        bool replay(ICodeListener *cl);
+
+    private:
+        typedef std::map<int, struct cl_type *>         TTypeMap;
+        typedef std::map<int, struct cl_var *>          TVarMap;
+
+        void                                   *map_;
+        size_t                                  size_;
+        const char                             *cursor_;
+        const char                             *end_;
+        bool                                    ok_;
+
+        // strings point directly to the memory-mapped file
+        std::vector<const char *>               strTab_;
+
+        // types and variables need to outlive the replay, CodeStorage refers
+        // to them
+        TTypeMap                                types_;
+        TVarMap                                 vars_;
+        std::deque<struct cl_operand>           ops_;
+        std::deque<struct cl_accessor>          acs_;
+        std::deque<struct cl_initializer>       initials_;
+
+        // storage of the operands of the record being currently replayed
+        struct cl_operand                       evOps_[/* max operands */ 2];
+        struct cl_loc                           evLoc_;
+
+        bool fail(const char *what);
+
+        unsigned long long getUInt();
+        long long getInt();
+        bool getBool() { return !!this->getUInt(); }
+        double getReal();
+        const char* getStr();
+        void getLoc(struct cl_loc *);
+        struct cl_type* getType();
+        struct cl_var* getVar();
+        void getOperand(struct cl_operand *);
+        const struct cl_operand* getOptOperand(struct cl_operand *);
+        void getInsn(struct cl_insn *);
+
+        void readString();
+        void readType();
+        void readVar();
+        bool replayOne(ICodeListener *cl, EBinTag tag);
+};
+
+BinReader::~BinReader()
+{
+    BOOST_FOREACH(TTypeMap::const_reference item, types_) {
+        struct cl_type *clt = item.second;
+        delete[] clt->items;
+        delete clt;
+    }
+
+    BOOST_FOREACH(TVarMap::const_reference item, vars_)
+        delete item.second;
+
+    if (map_)
+        munmap(map_, size_);
+}
+
+bool BinReader::fail(const char *what)
+{
+    if (ok_)
+        CL_ERROR("clReplayBinFile(): " << what);
+
+    ok_ = false;
+    cursor_ = end_;
+    return false;
+}
+
+bool BinReader::open(const char *fileName)
+{
+    const int fd = ::open(fileName, O_RDONLY);
+    if (fd < 0) {
+        CL_ERROR("unable to open file '" << fileName << "'");
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) || st.st_size <= 0) {
+        CL_ERROR("unable to read file '" << fileName << "'");
+        close(fd);
+        return false;
+    }
+
+    size_ = st.st_size;
+    void *map = mmap(0, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (MAP_FAILED == map) {
+        CL_ERROR("unable to map file '" << fileName << "'");
+        return false;
+    }
+
+    map_ = map;
+    cursor_ = static_cast<const char *>(map);
+    end_ = cursor_ + size_;
+
+    // check the header
+    if (size_ < sizeof BIN_FILE_MAGIC
+            || memcmp(cursor_, BIN_FILE_MAGIC, sizeof BIN_FILE_MAGIC))
+        return this->fail("not a binary code listener file");
+
+    cursor_ += sizeof BIN_FILE_MAGIC;
+    if (BIN_FILE_VERSION != this->getUInt())
+        return this->fail("unsupported version of the binary file");
+
+    // string ID 0 stands for NULL
+    strTab_.push_back(0);
+    return ok_;
+}
+
+unsigned long long BinReader::getUInt()
+{
+    unsigned long long val = 0ULL;
+    for (unsigned shift = 0U; cursor_ < end_ && shift < 64U; shift += 7U) {
+        const unsigned char byte = *cursor_++;
+        val |= static_cast<unsigned long long>(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+            return val;
+    }
+
+    this->fail("unexpected end of file");
+    return 0ULL;
+}
+
+long long BinReader::getInt()
+{
+    const unsigned long long uval = this->getUInt();
+    return (uval & 1ULL)
+        ? static_cast<long long>(~(uval >> 1))
+        : static_cast<long long>(uval >> 1);
+}
+
+double BinReader::getReal()
+{
+    const unsigned long long raw = this->getUInt();
+    double val;
+    memcpy(&val, &raw, sizeof val);
+    return val;
+}
+
+const char* BinReader::getStr()
+{
+    const unsigned long long id = this->getUInt();
+    if (strTab_.size() <= id) {
+        this->fail("reference to an undefined string");
+        return 0;
+    }
+
+    return strTab_[id];
+}
+
+void BinReader::getLoc(struct cl_loc *loc)
+{
+    loc->file       = this->getStr();
+    loc->line       = this->getInt();
+    loc->column     = this->getInt();
+    loc->sysp       = this->getBool();
+}
+
+struct cl_type* BinReader::getType()
+{
+    if (!this->getBool())
+        return 0;
+
+    // the type may be defined later on, create a place-holder if needed
+    const int uid = this->getInt();
+    struct cl_type *&clt = types_[uid];
+    if (!clt) {
+        clt = new struct cl_type();
+        clt->uid = uid;
+    }
+
+    return clt;
+}
+
+struct cl_var* BinReader::getVar()
+{
+    if (!this->getBool())
+        return 0;
+
+    // the variable may be defined later on, create a place-holder if needed
+    const int uid = this->getInt();
+    struct cl_var *&var = vars_[uid];
+    if (!var) {
+        var = new struct cl_var();
+        var->uid = uid;
+    }
+
+    return var;
+}
+
+void BinReader::getOperand(struct cl_operand *op)
+{
+    memset(op, 0, sizeof *op);
+    op->code = static_cast<enum cl_operand_e>(this->getUInt());
+    if (CL_OPERAND_VOID == op->code)
+        return;
+
+    op->scope = static_cast<enum cl_scope_e>(this->getUInt());
+    op->type = this->getType();
+
+    struct cl_accessor **pAc = &op->accessor;
+    while (ok_ && this->getBool()) {
+        acs_.push_back(cl_accessor());
+        struct cl_accessor *ac = &acs_.back();
+        ac->code = static_cast<enum cl_accessor_e>(this->getUInt());
+        ac->type = this->getType();
+        switch (ac->code) {
+            case CL_ACCESSOR_DEREF_ARRAY:
+                ops_.push_back(cl_operand());
+                ac->data.array.index = const_cast<struct cl_operand *>(
+                        this->getOptOperand(&ops_.back()));
+                break;
+
+            case CL_ACCESSOR_ITEM:
+                ac->data.item.id = this->getInt();
+                break;
+
+            case CL_ACCESSOR_OFFSET:
+                ac->data.offset.off = this->getInt();
+                break;
+
+            case CL_ACCESSOR_REF:
+            case CL_ACCESSOR_DEREF:
+                break;
+
+            default:
+                this->fail("invalid accessor code");
+        }
+
+        *pAc = ac;
+        pAc = &ac->next;
+    }
+
+    if (CL_OPERAND_VAR == op->code) {
+        op->data.var = this->getVar();
+        return;
+    }
+
+    if (CL_OPERAND_CST != op->code) {
+        this->fail("invalid operand code");
+        return;
+    }
+
+    struct cl_cst &cst = op->data.cst;
+    cst.code = static_cast<enum cl_type_e>(this->getUInt());
+    switch (cst.code) {
+        case CL_TYPE_FNC:
+            cst.data.cst_fnc.uid        = this->getInt();
+            cst.data.cst_fnc.name       = this->getStr();
+            cst.data.cst_fnc.is_extern  = this->getBool();
+            this->getLoc(&cst.data.cst_fnc.loc);
+            break;
+
+        case CL_TYPE_STRING:
+            cst.data.cst_string.value = this->getStr();
+            break;
+
+        case CL_TYPE_REAL:
+            cst.data.cst_real.value = this->getReal();
+            break;
+
+        default:
+            cst.data.cst_uint.value = this->getUInt();
+    }
+}
+
+const struct cl_operand* BinReader::getOptOperand(struct cl_operand *op)
+{
+    if (!this->getBool())
+        return 0;
+
+    this->getOperand(op);
+    return op;
+}
+
+void BinReader::getInsn(struct cl_insn *cli)
+{
+    memset(cli, 0, sizeof *cli);
+    cli->code = static_cast<enum cl_insn_e>(this->getUInt());
+    this->getLoc(&cli->loc);
+
+    // operands of instructions are kept as long as the reader lives
+    struct cl_operand *op[3];
+    for (int i = 0; i < 3; ++i) {
+        ops_.push_back(cl_operand());
+        op[i] = &ops_.back();
+    }
+
+    switch (cli->code) {
+        case CL_INSN_NOP:
+        case CL_INSN_ABORT:
+            break;
+
+        case CL_INSN_JMP:
+            cli->data.insn_jmp.label = this->getStr();
+            break;
+
+        case CL_INSN_COND:
+            cli->data.insn_cond.src         = this->getOptOperand(op[0]);
+            cli->data.insn_cond.then_label  = this->getStr();
+            cli->data.insn_cond.else_label  = this->getStr();
+            break;
+
+        case CL_INSN_RET:
+            cli->data.insn_ret.src = this->getOptOperand(op[0]);
+            break;
+
+        case CL_INSN_UNOP:
+            cli->data.insn_unop.code =
+                static_cast<enum cl_unop_e>(this->getUInt());
+            cli->data.insn_unop.dst         = this->getOptOperand(op[0]);
+            cli->data.insn_unop.src         = this->getOptOperand(op[1]);
+            break;
+
+        case CL_INSN_BINOP:
+            cli->data.insn_binop.code =
+                static_cast<enum cl_binop_e>(this->getUInt());
+            cli->data.insn_binop.dst        = this->getOptOperand(op[0]);
+            cli->data.insn_binop.src1       = this->getOptOperand(op[1]);
+            cli->data.insn_binop.src2       = this->getOptOperand(op[2]);
+            break;
+
+        case CL_INSN_LABEL:
+            cli->data.insn_label.name = this->getStr();
+            break;
+
+        default:
+            this->fail("invalid instruction code");
+    }
+}
+
+void BinReader::readString()
+{
+    const unsigned long long len = this->getUInt();
+    if (!len || static_cast<unsigned long long>(end_ - cursor_) < len
+            || cursor_[len - 1])
+    {
+        this->fail("invalid string definition");
+        return;
+    }
+
+    strTab_.push_back(cursor_);
+    cursor_ += len;
+}
+
+void BinReader::readType()
+{
+    struct cl_type *clt;
+    {
+        // reuse the place-holder if already referred
+        const int uid = this->getInt();
+        struct cl_type *&ref = types_[uid];
+        if (!ref)
+            ref = new struct cl_type();
+        else if (ref->items)
+            // do not leak the items of the previous definition
+            delete[] ref->items;
+
+        clt = ref;
+        clt->uid = uid;
+    }
+
+    clt->code = static_cast<enum cl_type_e>(this->getUInt());
+    this->getLoc(&clt->loc);
+    clt->scope = static_cast<enum cl_scope_e>(this->getUInt());
+    clt->name = this->getStr();
+    clt->size = this->getInt();
+
+    const int cnt = this->getInt();
+    if (cnt < 0 || static_cast<size_t>(end_ - cursor_) < 3U * size_t(cnt)) {
+        this->fail("invalid count of nested types");
+        return;
+    }
+
+    clt->item_cnt = cnt;
+    clt->items = (cnt)
+        ? new struct cl_type_item[cnt]
+        : 0;
+
+    for (int i = 0; i < cnt; ++i) {
+        struct cl_type_item &item = clt->items[i];
+        item.type   = this->getType();
+        item.name   = this->getStr();
+        item.offset = this->getInt();
+    }
+
+    clt->array_size = this->getInt();
+    clt->is_unsigned = this->getBool();
+}
+
+void BinReader::readVar()
+{
+    struct cl_var *var;
+    {
+        // reuse the place-holder if already referred
+        const int uid = this->getInt();
+        struct cl_var *&ref = vars_[uid];
+        if (!ref)
+            ref = new struct cl_var();
+
+        var = ref;
+        var->uid = uid;
+    }
+
+    var->name           = this->getStr();
+    var->artificial     = this->getBool();
+    this->getLoc(&var->loc);
+    var->initialized    = this->getBool();
+    var->is_extern      = this->getBool();
+
+    struct cl_initializer **pInit = &var->initial;
+    while (ok_ && this->getBool()) {
+        initials_.push_back(cl_initializer());
+        struct cl_initializer *in = &initials_.back();
+        this->getInsn(&in->insn);
+        *pInit = in;
+        pInit = &in->next;
+    }
+}
+
+bool BinReader::replayOne(ICodeListener *cl, const EBinTag tag)
+{
+    // the accessors of operands given to call-backs are not needed afterwards
+    const size_t acMark = acs_.size();
+    const size_t opMark = ops_.size();
+
+    struct cl_operand *const op = evOps_;
+    struct cl_loc *const loc = &evLoc_;
+    struct cl_insn cli;
+    int argId;
+    const char *str;
+    const struct cl_operand *op1, *op2;
+
+    // first read the whole record, then call the listener
+    switch (tag) {
+        case BT_FILE_OPEN:
+        case BT_BB_OPEN:
+            str = this->getStr();
+            if (!ok_)
+                return false;
+            if (BT_FILE_OPEN == tag)
+                cl->file_open(str);
+            else
+                cl->bb_open(str);
+            break;
+
+        case BT_FNC_OPEN:
+            this->getOperand(op);
+            if (!ok_)
+                return false;
+            cl->fnc_open(op);
+            break;
+
+        case BT_FNC_ARG_DECL:
+        case BT_CALL_ARG:
+            argId = this->getInt();
+            if (BT_FNC_ARG_DECL == tag) {
+                this->getOperand(op);
+                if (!ok_)
+                    return false;
+                cl->fnc_arg_decl(argId, op);
+            }
+            else {
+                op1 = this->getOptOperand(op);
+                if (!ok_)
+                    return false;
+                cl->insn_call_arg(argId, op1);
+            }
+            break;
+
+        case BT_INSN:
+            this->getInsn(&cli);
+            if (!ok_)
+                return false;
+            cl->insn(&cli);
+            break;
+
+        case BT_CALL_OPEN:
+            this->getLoc(loc);
+            op1 = this->getOptOperand(&op[0]);
+            op2 = this->getOptOperand(&op[1]);
+            if (!ok_)
+                return false;
+            cl->insn_call_open(loc, op1, op2);
+            break;
+
+        case BT_SWITCH_OPEN:
+            this->getLoc(loc);
+            op1 = this->getOptOperand(op);
+            if (!ok_)
+                return false;
+            cl->insn_switch_open(loc, op1);
+            break;
+
+        case BT_SWITCH_CASE:
+            this->getLoc(loc);
+            op1 = this->getOptOperand(&op[0]);
+            op2 = this->getOptOperand(&op[1]);
+            str = this->getStr();
+            if (!ok_)
+                return false;
+            cl->insn_switch_case(loc, op1, op2, str);
+            break;
+
+        case BT_FILE_CLOSE:
+            cl->file_close();
+            break;
+
+        case BT_FNC_CLOSE:
+            cl->fnc_close();
+            break;
+
+        case BT_CALL_CLOSE:
+            cl->insn_call_close();
+            break;
+
+        case BT_SWITCH_CLOSE:
+            cl->insn_switch_close();
+            break;
+
+        default:
+            return this->fail("invalid record tag");
+    }
+
+    acs_.resize(acMark);
+    ops_.resize(opMark);
+    return true;
+}
+
+bool BinReader::replay(ICodeListener *cl)
+{
+    while (ok_ && cursor_ < end_) {
+        const EBinTag tag = static_cast<EBinTag>(
+                static_cast<unsigned char>(*cursor_++));
+        switch (tag) {
+            case BT_STRING:
+                this->readString();
+                break;
+
+            case BT_TYPE:
+                this->readType();
+                break;
+
+            case BT_VAR:
+                this->readVar();
+                break;
+
+            case BT_ACK:
+                if (cursor_ != end_)
+                    return this->fail("trailing data after acknowledge()");
+
+                cl->acknowledge();
+                return true;
+
+            default:
+                this->replayOne(cl, tag);
+        }
+    }
+
+    return this->fail("the file ends without acknowledge()");
+}
+
+// /////////////////////////////////////////////////////////////////////////////
+// interface, see cl_binfile.hh for details
+ICodeListener* createClBinWriter(const char *configString)
+{
+    return new ClBinWriter(configString);
+}
+
+bool clReplayBinFile(const char *fileName, ICodeListener *cl)
+{
+    bool ok = false;
+    {
+        BinReader reader;
+        if (reader.open(fileName)) {
+            CL_DEBUG("clReplayBinFile: replaying '" << fileName << "'");
+            ok = reader.replay(cl);
+        }
+
+        // the listener may refer to the data owned by the reader till the end
+        delete cl;
+    }
+
+    return ok;
+}
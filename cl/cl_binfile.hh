@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef H_GUARD_CL_BINFILE_H
+#define H_GUARD_CL_BINFILE_H
+
+/**
+ * @file cl_binfile.hh
+ * constructor createClBinWriter() of the @b "binwriter" code listener and
+ * clReplayBinFile(), which feeds the recorded code into another code listener
+ *
+ * The binary file is a stream of records, each of them starting with a single
+ * byte tag.  Strings, types, and variables are defined once by a record of
+ * their own (preceding the first record that refers to them) and then referred
+ * by their IDs.  All integers are stored as (zig-zag encoded) variable-length
+ * quantities, so the file does not depend on the byte order of the host.
+ * Strings are stored including their trailing zero, which allows to use them
+ * directly from the memory-mapped file while replaying.
+ */
+
+class ICodeListener;
+
+/**
+ * create "binwriter" ICodeListener implementation
+ * @param config_string Name of the output file is the only configuration
+ * string for now. It's an compulsory argument and can't be NULL.
+ */
+ICodeListener* createClBinWriter(const char *config_string);
+
+/**
+ * replay the code recorded by the "binwriter" listener
+ * @param fileName name of the binary file to read
+ * @param cl the code listener to be fed by the recorded call-backs, including
+ * the final acknowledge() if the file was complete
+ * @note The listener is destroyed by clReplayBinFile() before it returns since
+ * the replayed types and variables are not valid any longer afterwards.
+ * @return true if the whole file has been read and replayed successfully
+ */
+bool clReplayBinFile(const char *fileName, ICodeListener *cl);
+
+#endif /* H_GUARD_CL_BINFILE_H */
@@ -23,6 +23,7 @@
 #include <cl/cl_msg.hh>
 #include <cl/easy.hh>
 #include <cl/memdebug.hh>
+#include <cl/plotwriter.hh>
 #include <cl/storage.hh>
 
 #include "callgraph.hh"
@@ -31,9 +32,13 @@
 #include "loopscan.hh"
 #include "pointsto.hh"
 #include "stopwatch.hh"
+#include "taskgraph.hh"
 
+#include <functional>
 #include <string>
 
+#include <boost/foreach.hpp>
+
 #define _CL_PRINT_TIME(mech, watch) mech("clEasyRun() took " << watch)
 
 #if CL_EASY_TIMER
@@ -61,32 +66,64 @@ class ClEasy: public ClStorageBuilder {
                 return;
             }
 
-            CL_DEBUG("building call-graph...");
-            CodeStorage::CallGraph::buildCallGraph(stor);
-            printMemUsage("buildCallGraph");
-
-            CL_DEBUG("scanning CFG for loop-closing edges...");
-            findLoopClosingEdges(stor);
-            printMemUsage("findLoopClosingEdges");
-
-            CL_DEBUG("perform points-to analysis...");
-            pointsToAnalyse(stor, configString_);
-            printMemUsage("pointsToAnalyse");
-
-            CL_DEBUG("killing local variables...");
-            killLocalVariables(stor);
-            printMemUsage("killLocalVariables");
+            CL_DEBUG("preprocessing CodeStorage::Storage...");
+            this->preprocess(stor);
+            printMemUsage("preprocess");
 
             CL_DEBUG("ClEasy is calling the analyzer...");
             StopWatch watch;
             clEasyRun(stor, configString_.c_str());
+
+            // wait for the plots still being written in the background
+            flushPlotFiles();
             CL_PRINT_TIME(watch);
         }
 
     private:
         std::string configString_;
+
+        void preprocess(CodeStorage::Storage &stor);
 };
 
+void ClEasy::preprocess(CodeStorage::Storage &stor)
+{
+    using namespace CodeStorage;
+    using std::bind;
+    using std::ref;
+
+    // the passes (and their per-function parts) are scheduled by TaskGraph
+    TaskGraph tg;
+
+    // the call graph is built as a whole
+    const TaskGraph::TPassId cg = tg.addPass("buildCallGraph");
+    tg.addTask(cg, bind(&CallGraph::buildCallGraph, ref(stor)));
+
+    // the points-to analysis needs the call graph
+    const TaskGraph::TPassId pt = tg.addPass("pointsToAnalyse");
+    tg.addTask(pt, bind(&pointsToAnalyse, ref(stor), configString_));
+    tg.addDep(pt, cg);
+
+    // the variable killer needs the points-to info
+    const TaskGraph::TPassId vk =
+        tg.addPass("killLocalVariables", &printVarKillerStats);
+    tg.addDep(vk, pt);
+
+    // scanning for loop-closing edges does not depend on anything
+    const TaskGraph::TPassId ls = tg.addPass("findLoopClosingEdges");
+
+    void (*const killFnc)(Fnc &) = &killLocalVariables;
+    void (*const scanFnc)(Fnc &) = &findLoopClosingEdges;
+    BOOST_FOREACH(Fnc *fnc, stor.fncs) {
+        if (!isDefined(*fnc))
+            continue;
+
+        tg.addTask(ls, bind(scanFnc, ref(*fnc)));
+        tg.addTask(vk, bind(killFnc, ref(*fnc)));
+    }
+
+    tg.run();
+}
+
 
 // /////////////////////////////////////////////////////////////////////////////
 // interface, see cl_easy.hh for details
@@ -21,6 +21,7 @@
 
 #include <cl/cl_msg.hh>
 
+#include "cl_binfile.hh"
 #include "cl_dotgen.hh"
 #include "cl_easy.hh"
 #include "cl_factory.hh"
@@ -295,6 +296,7 @@ struct ClFactory::Private {
 ClFactory::ClFactory():
     d(new Private)
 {
+    d->map["binwriter"]     = &createClBinWriter;
     d->map["dotgen"]        = &createClDotGenerator;
     d->map["easy"]          = &createClEasy;
     d->map["locator"]       = &createClLocator;
@@ -35,20 +35,23 @@
 
 namespace CodeStorage {
     /**
-     * @param str dst/src to call strdup(3) for
+     * duplicate strings into the given Arena object
      */
-    void dupString(const char *&str) {
-        str = (str)
-            ? strdup(str)
-            : 0;
-    }
+    struct StringCloner {
+        Arena &arena;
 
-    /**
-     * @param str Legacy string to be freed, usually formerly given by dupString
-     */
-    void freeString(const char *str) {
-        free(const_cast<char *>(str));
-    }
+        StringCloner(Arena &arena_):
+            arena(arena_)
+        {
+        }
+
+        /**
+         * @param str dst/src to call Arena::dupString() for
+         */
+        void operator()(const char *&str) const {
+            str = arena.dupString(str);
+        }
+    };
 
     /**
      * @param fnc An arbitrary function we should call on any (valid) string
@@ -100,22 +103,23 @@ namespace CodeStorage {
     /**
      * clone a chain of cl_accessor objects and eventually push all array
      * indexes to given stack
+     * @param arena The Arena object to allocate the clones from.
      * @param dst Where to store just cloned cl_accessor chain.
      * @param src The chain of cl_accessor objects being cloned.
      * @param opStack Stack to push all array indexes to.
      */
     template <class TStack>
-    void cloneAccessor(struct cl_accessor **dst, const struct cl_accessor *src,
-                       TStack &opStack)
+    void cloneAccessor(Arena &arena, struct cl_accessor **dst,
+                       const struct cl_accessor *src, TStack &opStack)
     {
         while (src) {
             // clone current cl_accessor object
-            *dst = new struct cl_accessor(*src);
+            *dst = arena.create(*src);
 
             if (CL_ACCESSOR_DEREF_ARRAY == src->code) {
                 // clone array index
                 struct cl_operand const *idxSrc = src->data.array.index;
-                struct cl_operand *idxDst = new struct cl_operand(*idxSrc);
+                struct cl_operand *idxDst = arena.create(*idxSrc);
                 (*dst)->data.array.index = idxDst;
 
                 // schedule array index as an operand for the next wheel
@@ -129,10 +133,13 @@ namespace CodeStorage {
     }
 
     /**
-     * deep copy of a cl_operand object
+     * deep copy of a cl_operand object, the clones are allocated from arena
+     * and released together with it
      * @note FIXME: I guess this will need a debugger first :-)
      */
-    void storeOperand(struct cl_operand &dst, const struct cl_operand *src) {
+    void storeOperand(Arena &arena, struct cl_operand &dst,
+                      const struct cl_operand *src)
+    {
         // shallow copy
         dst = *src;
 
@@ -153,52 +160,16 @@ namespace CodeStorage {
 
             // clone list of cl_accessor objects
             // and schedule all array indexes for the next wheel eventually
-            cloneAccessor(&cDst->accessor, cSrc->accessor, opStack);
+            cloneAccessor(arena, &cDst->accessor, cSrc->accessor, opStack);
 
             // duplicate all strings
-            handleOperandStrings(dupString, cDst);
+            handleOperandStrings(StringCloner(arena), cDst);
         }
     }
 
-    /**
-     * free all data allocated previously by storeOperand()
-     */
-    void releaseOperand(struct cl_operand &ref) {
-        if (CL_OPERAND_VOID == ref.code)
-            // nothing to free
-            return;
-
-        // use std::stack to avoid recursion
-        std::stack<struct cl_operand *> opStack;
-        opStack.push(&ref);
-        while (!opStack.empty()) {
-            struct cl_operand *op = opStack.top();
-            opStack.pop();
-
-            // remove all duplicated strings
-            handleOperandStrings(freeString, op);
-
-            // destroy cl_accessor objects recursively
-            struct cl_accessor *ac = op->accessor;
-            while (ac) {
-                struct cl_accessor *next = ac->next;
-                if (CL_ACCESSOR_DEREF_ARRAY == ac->code)
-                    opStack.push(ac->data.array.index);
-
-                delete ac;
-                ac = next;
-            }
-
-            if (op != &ref)
-                // free cloned array index
-                delete op;
-        }
-
-        // all accessors freed
-        ref.accessor = 0;
-    }
-
-    void storeLabel(struct cl_operand &op, const struct cl_insn *cli) {
+    void storeLabel(Arena &arena, struct cl_operand &op,
+                    const struct cl_insn *cli)
+    {
         const char *name = cli->data.insn_label.name;
         struct cl_operand tpl;
         tpl.code = CL_OPERAND_VOID;
@@ -212,13 +183,26 @@ namespace CodeStorage {
             tpl.data.cst.data.cst_string.value  = name;
         }
 
-        storeOperand(op, &tpl);
+        storeOperand(arena, op, &tpl);
     }
 
-    Insn* createInsn(const struct cl_insn *cli, ControlFlow *cfg) {
+    /**
+     * allocate an Insn object from the arena of the given Storage object, the
+     * instructions of a basic block are thus placed next to each other
+     */
+    Insn* allocInsn(Storage &stor) {
+        Insn *insn = stor.arena.create<Insn>();
+        insn->stor = &stor;
+        return insn;
+    }
+
+    Insn* createInsn(Storage &stor, const struct cl_insn *cli,
+                     ControlFlow *cfg)
+    {
         enum cl_insn_e code = cli->code;
+        Arena &arena = stor.arena;
 
-        Insn *insn = new Insn;
+        Insn *insn = allocInsn(stor);
         insn->code = cli->code;
         insn->loc = cli->loc;
 
@@ -236,7 +220,7 @@ namespace CodeStorage {
 
             case CL_INSN_COND:
                 operands.resize(1);
-                storeOperand(operands[0], cli->data.insn_cond.src);
+                storeOperand(arena, operands[0], cli->data.insn_cond.src);
 
                 targets.resize(2);
                 targets[0] = cfg->operator[](cli->data.insn_cond.then_label);
@@ -245,7 +229,7 @@ namespace CodeStorage {
 
             case CL_INSN_RET:
                 operands.resize(1);
-                storeOperand(operands[0], cli->data.insn_ret.src);
+                storeOperand(arena, operands[0], cli->data.insn_ret.src);
                 // fall through!
 
             case CL_INSN_ABORT:
@@ -254,16 +238,16 @@ namespace CodeStorage {
             case CL_INSN_UNOP:
                 insn->subCode = static_cast<int> (cli->data.insn_unop.code);
                 operands.resize(2);
-                storeOperand(operands[0], cli->data.insn_unop.dst);
-                storeOperand(operands[1], cli->data.insn_unop.src);
+                storeOperand(arena, operands[0], cli->data.insn_unop.dst);
+                storeOperand(arena, operands[1], cli->data.insn_unop.src);
                 break;
 
             case CL_INSN_BINOP:
                 insn->subCode = static_cast<int> (cli->data.insn_binop.code);
                 operands.resize(3);
-                storeOperand(operands[0], cli->data.insn_binop.dst);
-                storeOperand(operands[1], cli->data.insn_binop.src1);
-                storeOperand(operands[2], cli->data.insn_binop.src2);
+                storeOperand(arena, operands[0], cli->data.insn_binop.dst);
+                storeOperand(arena, operands[1], cli->data.insn_binop.src1);
+                storeOperand(arena, operands[2], cli->data.insn_binop.src2);
                 break;
 
             case CL_INSN_CALL:
@@ -276,18 +260,19 @@ namespace CodeStorage {
 
             case CL_INSN_LABEL:
                 operands.resize(1);
-                storeLabel(operands[0], cli);
+                storeLabel(arena, operands[0], cli);
                 break;
         }
 
         return insn;
     }
 
+    /**
+     * the memory of Insn objects (including their operands) is owned by the
+     * arena, we only need to run the destructor
+     */
     void destroyInsn(Insn *insn) {
-        BOOST_FOREACH(struct cl_operand &op, insn->operands) {
-            releaseOperand(op);
-        }
-        delete insn;
+        insn->~Insn();
     }
 
     void destroyBlock(Block *bb) {
@@ -298,7 +283,6 @@ namespace CodeStorage {
     }
 
     void destroyFnc(Fnc *fnc) {
-        releaseOperand(fnc->def);
         BOOST_FOREACH(const Block *bb, fnc->cfg) {
             destroyBlock(const_cast<Block *>(bb));
         }
@@ -365,8 +349,7 @@ void ClStorageBuilder::Private::digInitials(const TOp *op)
 
     const struct cl_initializer *initial;
     for (initial = clv->initial; initial; initial = initial->next) {
-        Insn *insn = createInsn(&initial->insn, /* cfg */ 0);
-        insn->stor = &stor;
+        Insn *insn = createInsn(stor, &initial->insn, /* cfg */ 0);
 
         // initializer instructions are not associated with any basic block
         insn->bb = 0;
@@ -461,7 +444,7 @@ void ClStorageBuilder::Private::digOperandCst(const struct cl_operand *op)
     // store fnc declaration if not already
     struct cl_operand &def = fnc->def;
     if (CL_OPERAND_VOID == def.code)
-        storeOperand(def, op);
+        storeOperand(stor.arena, def, op);
 
     // select the appropriate name mapping by scope
     NameDb::TNameMap &nameMap = (CL_SCOPE_GLOBAL == scope)
@@ -526,8 +509,7 @@ void ClStorageBuilder::Private::digOperand(const TOp *op)
 
 void ClStorageBuilder::Private::openInsn(Insn *newInsn)
 {
-    // set pointer to the owning instance of Storage
-    newInsn->stor = &this->stor;
+    CL_BREAK_IF(newInsn->stor != &this->stor);
 
     // check there is no insn already opened
     CL_BREAK_IF(insn);
@@ -593,7 +575,7 @@ void ClStorageBuilder::fnc_open(const struct cl_operand *op)
 
     // store fnc definition
     struct cl_operand &def = fnc->def;
-    storeOperand(def, op);
+    storeOperand(d->stor.arena, def, op);
     d->digOperand(&def);
 
     // let it honestly crash if callback sequence is incorrect since this should
@@ -635,7 +617,7 @@ void ClStorageBuilder::insn(const struct cl_insn *cli)
         return;
 
     // serialize given insn
-    Insn *insn = createInsn(cli, &d->fnc->cfg);
+    Insn *insn = createInsn(d->stor, cli, &d->fnc->cfg);
     d->openInsn(insn);
 
     // current insn is actually already complete
@@ -648,14 +630,15 @@ void ClStorageBuilder::insn_call_open(
     const struct cl_operand *dst,
     const struct cl_operand *fnc)
 {
-    Insn *insn = new Insn;
+    Insn *insn = allocInsn(d->stor);
     insn->code = CL_INSN_CALL;
     insn->loc = *loc;
 
+    Arena &arena = d->stor.arena;
     TOperandList &operands = insn->operands;
     operands.resize(2);
-    storeOperand(operands[0], dst);
-    storeOperand(operands[1], fnc);
+    storeOperand(arena, operands[0], dst);
+    storeOperand(arena, operands[1], fnc);
 
     // prevent existing reference marks '&' on operands to be taken into account
     // for operands of some internal handlers like VK_ASSERT() or PT_ASSERT().
@@ -669,7 +652,7 @@ void ClStorageBuilder::insn_call_arg(int, const struct cl_operand *arg_src)
     TOperandList &operands = d->insn->operands;
     unsigned idx = operands.size();
     operands.resize(idx + 1);
-    storeOperand(operands[idx], arg_src);
+    storeOperand(d->stor.arena, operands[idx], arg_src);
 }
 
 void ClStorageBuilder::insn_call_close()
@@ -684,14 +667,14 @@ void ClStorageBuilder::insn_switch_open(
     const struct cl_loc     *loc,
     const struct cl_operand *src)
 {
-    Insn *insn = new Insn;
+    Insn *insn = allocInsn(d->stor);
     insn->code = CL_INSN_SWITCH;
     insn->loc = *loc;
 
     // store src operand
     TOperandList &operands = insn->operands;
     operands.resize(1);
-    storeOperand(operands[0], src);
+    storeOperand(d->stor.arena, operands[0], src);
 
     // reserve for default
     insn->targets.push_back(static_cast<Block *>(0));
@@ -746,7 +729,7 @@ void ClStorageBuilder::insn_switch_case(
 
         // store case value
         operands.resize(idx + 1);
-        storeOperand(operands[idx], &val);
+        storeOperand(d->stor.arena, operands[idx], &val);
 
         // store case target
         targets.resize(idx + 1);
@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file clrun.cc
+ * main() of the standalone runner, which feeds the code recorded by the gcc
+ * plug-in (see -fplugin-arg-NAME-dump-bin) into the analyzer linked with it,
+ * without any need to run gcc again
+ */
+
+#include "config_cl.h"
+
+#include <cl/cl_msg.hh>
+#include <cl/code_listener.h>
+
+#include "cl.hh"
+#include "cl_binfile.hh"
+#include "cl_factory.hh"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include <unistd.h>
+
+static const char *app_name = "clrun";
+static int error_cnt = 0;
+
+static void print_msg(const char *msg)
+{
+    fprintf(stderr, "%s\n", msg);
+}
+
+static void print_error(const char *msg)
+{
+    ++error_cnt;
+    print_msg(msg);
+}
+
+static void no_msg(const char *)
+{
+}
+
+static void die_msg(const char *msg)
+{
+    print_msg(msg);
+    exit(EXIT_FAILURE);
+}
+
+static void usage(FILE *out)
+{
+    fprintf(out, "Usage: %s [-v VERBOSITY_LEVEL] [-a ANALYZER_ARGS] FILE...\n"
+            "\n"
+            "Replay each FILE written by -fplugin-arg-NAME-dump-bin=FILE and "
+            "run the analyzer\non it.  The exit code is non-zero if any error "
+            "has been reported.\n", app_name);
+}
+
+/// quote the given string as expected by ClFactory::create()
+static std::string quote(const char *str)
+{
+    std::string dst("\"");
+    for (; *str; ++str) {
+        if ('"' == *str || '\\' == *str)
+            dst.push_back('\\');
+
+        dst.push_back(*str);
+    }
+
+    dst.push_back('"');
+    return dst;
+}
+
+static bool run_file(const char *file_name, const char *args)
+{
+    // the code has already passed through the filters used for the analyzer
+    // while being recorded, so we do not ask for any clf= here
+    const std::string config = "listener=\"easy\" listener_args="
+        + quote(args);
+
+    ClFactory factory;
+    ICodeListener *cl = factory.create(config.c_str());
+    if (!cl)
+        // error message already emitted
+        return false;
+
+    return clReplayBinFile(file_name, cl);
+}
+
+int main(int argc, char *argv[])
+{
+    if (argv[0])
+        app_name = argv[0];
+
+    static struct cl_init_data init = {
+        /* .debug       */ no_msg,
+        /* .warn        */ print_msg,
+        /* .error       */ print_error,
+        /* .note        */ print_msg,
+        /* .die         */ die_msg,
+        /* .debug_level */ 0
+    };
+
+    const char *args = "";
+
+    int opt;
+    while (-1 != (opt = getopt(argc, argv, "a:hv:"))) {
+        switch (opt) {
+            case 'a':
+                args = optarg;
+                break;
+
+            case 'v':
+                if ((init.debug_level = atoi(optarg)))
+                    init.debug = print_msg;
+                break;
+
+            case 'h':
+                usage(stdout);
+                return EXIT_SUCCESS;
+
+            default:
+                usage(stderr);
+                return EXIT_FAILURE;
+        }
+    }
+
+    if (argc <= optind) {
+        usage(stderr);
+        return EXIT_FAILURE;
+    }
+
+    cl_global_init(&init);
+
+    bool ok = true;
+    for (int i = optind; i < argc; ++i)
+        ok &= run_file(argv[i], args);
+
+    cl_global_cleanup();
+
+    return (ok && !error_cnt)
+        ? EXIT_SUCCESS
+        : EXIT_FAILURE;
+}
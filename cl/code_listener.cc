@@ -32,6 +32,17 @@
 
 #include <unistd.h>
 
+#if CL_MSG_THREAD_SAFE
+#   include <mutex>
+
+    // guards the message callbacks and the state used by CHK_LAST
+    static std::mutex msg_mutex;
+
+#   define MSG_LOCK std::lock_guard<std::mutex> guard(msg_mutex)
+#else
+#   define MSG_LOCK do { } while (0)
+#endif
+
 #if CL_MSG_SQUEEZE_REPEATS
     static std::string last_msg;
 
@@ -93,23 +104,27 @@ static struct cl_init_data init_data = {
 
 void cl_debug(const char *msg)
 {
+    MSG_LOCK;
     init_data.debug(msg);
 }
 
 void cl_warn(const char *msg)
 {
+    MSG_LOCK;
     CHK_LAST(msg, /* filter */ true);
     init_data.warn(msg);
 }
 
 void cl_error(const char *msg)
 {
+    MSG_LOCK;
     CHK_LAST(msg, /* filter */ true);
     init_data.error(msg);
 }
 
 void cl_note(const char *msg)
 {
+    MSG_LOCK;
     CHK_LAST(msg, /* filter */ false);
     init_data.note(msg);
 }
@@ -92,6 +92,28 @@
  */
 #define CL_MSG_SQUEEZE_REPEATS          1
 
+/**
+ * if 1, serialize the messages sent by cl_debug(), cl_warn(), etc., such that
+ * they can be emitted by multiple threads (e.g. by CL_PREPROCESS_THREADS)
+ * @note the resulting binaries need to be linked with -pthread in that case
+ */
+#define CL_MSG_THREAD_SAFE              1
+
+/**
+ * max count of plots waiting for the background thread that formats them and
+ * writes them to disk, see plotwriter.hh (0 means it is done synchronously)
+ * @note the resulting binaries need to be linked with -pthread unless it is 0
+ */
+#define CL_PLOT_WRITER_QUEUE            0x40
+
+/**
+ * max number of threads used to run the (per-function) preprocessing passes
+ * over CodeStorage, see TaskGraph (0 means no threads at all)
+ * @note the resulting binaries need to be linked with -pthread unless it is 0,
+ * which build-aux/common.cmake takes care of
+ */
+#define CL_PREPROCESS_THREADS           4
+
 /**
  * if 1, do not check for unused local variables and registers
  */
@@ -158,6 +158,7 @@ static struct plugin_info cl_info = {
 "    -fplugin-arg-%s-version\n"
 "    -fplugin-arg-%s-args=PEER_ARGS                 args given to analyzer\n"
 "    -fplugin-arg-%s-dry-run                        do not run the analyzer\n"
+"    -fplugin-arg-%s-dump-bin=OUTPUT_FILE           dump code for later runs\n"
 "    -fplugin-arg-%s-dump-pp[=OUTPUT_FILE]          dump linearized code\n"
 "    -fplugin-arg-%s-dump-types                     dump also type info\n"
 "    -fplugin-arg-%s-gen-dot[=GLOBAL_CG_FILE]       generate CFGs\n"
@@ -211,7 +212,8 @@ static void init_plugin_name(const struct plugin_name_args *info)
     if (-1 == asprintf(&msg, cl_info.help, plugin_base_name,
                        name, name, name, name,
                        name, name, name, name,
-                       name, name, name, name))
+                       name, name, name, name,
+                       name))
         // OOM
         abort();
     else
@@ -1961,10 +1963,12 @@ struct cl_plug_options {
     bool                    use_pp;
     bool                    use_analyzer;
     bool                    use_typedot;
+    bool                    use_binwriter;
     const char              *gl_dot_file;
     const char              *pp_out_file;
     const char              *analyzer_args;
     const char              *type_dot_file;
+    const char              *bin_out_file;
     const char              *pid_file;
 };
 
@@ -2011,6 +2015,16 @@ static int clplug_init(const struct plugin_name_args *info,
             opt->use_analyzer   = false;
             // TODO: warn about ignoring extra value?
         }
+        else if (STREQ(key, "dump-bin")) {
+            if (value) {
+                opt->use_binwriter  = true;
+                opt->bin_out_file   = value;
+            }
+            else {
+                CL_ERROR("mandatory value omitted for dump-bin");
+                return EXIT_FAILURE;
+            }
+        }
         else if (STREQ(key, "dump-pp")) {
             opt->use_pp         = true;
             opt->pp_out_file    = value;
@@ -2131,6 +2145,12 @@ create_cl_chain(const struct cl_plug_options *opt)
                 opt->type_dot_file, opt))
         return NULL;
 
+    // record the code as seen by the analyzer, regardless of dry-run
+    if (opt->use_binwriter && !cl_append_listener(chain,
+                "listener=\"binwriter\" listener_args=\"%s\" "
+                "clf=\"unfold_switch,unify_labels_gl\"", opt->bin_out_file))
+        return NULL;
+
     if (opt->use_analyzer
             && !cl_append_def_listener(chain, "easy", opt->analyzer_args, opt))
         return NULL;
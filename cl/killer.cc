@@ -28,11 +28,20 @@
 #include "pointsto.hh"
 #include "builtins.hh"
 #include "stopwatch.hh"
+#include "taskgraph.hh"
 #include "util.hh"
 
+#include <algorithm>
+#include <functional>
 #include <map>
 #include <set>
+#include <vector>
 
+#if CL_PREPROCESS_THREADS
+#   include <mutex>
+#endif
+
+#include <boost/dynamic_bitset.hpp>
 #include <boost/foreach.hpp>
 
 static int debugVarKiller = CL_DEBUG_VAR_KILLER;
@@ -59,8 +68,9 @@ typedef const CodeStorage::Var             *TStorVar;
 typedef const CodeStorage::Fnc             *TFnc;
 typedef std::set<TVar>                      TSet;
 typedef const Block                        *TBlock;
-typedef std::set<TBlock>                    TBlockSet;
+typedef std::vector<TBlock>                 TBlockList;
 typedef std::vector<TSet>                   TLivePerTarget;
+typedef boost::dynamic_bitset<>             TBits;
 
 /// per-block data
 struct BlockData {
@@ -75,14 +85,17 @@ typedef std::map<int, int>                  TAliasMap;
 /// shared data
 struct Data {
     TStorRef                                stor;
-    TBlockSet                               todo;
     TMap                                    blocks;
     TFnc                                    fnc;
     TAliasMap                               derefAliases;
+    int                                     cntPtKilled;
+    int                                     cntKilled;
 
     Data(TStorRef stor_):
         stor(stor_),
-        fnc(0)
+        fnc(0),
+        cntPtKilled(0),
+        cntKilled(0)
     {
     }
 };
@@ -124,14 +137,15 @@ PTStats *PTStats::inst = 0;
 
 void countPtStat(Data &data, int uid)
 {
-    PTStats *stats = PTStats::getInstance();
-    stats->fullCount++;
+    // the statistics are accumulated per function and summed up later on, so
+    // that functions can be analyzed independently of each other
+    data.cntKilled++;
 
     if (hasKey(data.fnc->vars, uid))
         // is local uid
         return;
 
-    stats->count ++;
+    data.cntPtKilled++;
 
     // killing pointer target
     VK_DEBUG(0, "killling " << uid << " by its pointer!");
@@ -273,52 +287,149 @@ void scanInsn(Data &data, BlockData &bData, const Insn &insn)
     }
 }
 
-void updateBlock(Data &data, TBlock bb)
+/// dense numbering of the variables and blocks of a single function
+struct FncIndex {
+    std::vector<TVar>                       uidByIdx;
+    TBlockList                              blocks;
+    std::map<TBlock, unsigned>              posByBlock;
+
+    unsigned idxByUid(const TVar uid) const {
+        // uidByIdx is sorted, so the indexes preserve the ordering of uids
+        return std::lower_bound(uidByIdx.begin(), uidByIdx.end(), uid)
+            - uidByIdx.begin();
+    }
+
+    TBits toBits(const TSet &vars) const {
+        TBits bits(uidByIdx.size());
+        BOOST_FOREACH(const TVar uid, vars)
+            bits.set(this->idxByUid(uid));
+
+        return bits;
+    }
+
+    void fromBits(TSet &dst, const TBits &bits) const {
+        dst.clear();
+        for (TBits::size_type i = bits.find_first(); TBits::npos != i;
+                i = bits.find_next(i))
+            // the input is sorted, so each insertion happens at the end
+            dst.insert(dst.end(), uidByIdx[i]);
+    }
+};
+
+/// number the variables used and blocks (in post-order) of the given function
+void indexFnc(FncIndex &idx, const Data &data, const Fnc &fnc)
 {
-    VK_DEBUG_MSG(2, &bb->front()->loc, "updateBlock: " << bb->name());
-    BlockData &bData = data.blocks[bb];
-    bool anyChange = false;
+    // collect all the variables generated or killed by any block
+    TSet vars;
+    BOOST_FOREACH(TMap::const_reference item, data.blocks) {
+        const BlockData &bData = item.second;
+        vars.insert(bData.gen.begin(), bData.gen.end());
+        vars.insert(bData.kill.begin(), bData.kill.end());
+    }
+    idx.uidByIdx.assign(vars.begin(), vars.end());
 
-    // go through all variables generated by successors
-    BOOST_FOREACH(TBlock bbSrc, bb->targets()) {
-        BlockData &bDataSrc = data.blocks[bbSrc];
+    // post-order of the CFG, visits the successors of a block before the block
+    typedef std::pair<TBlock, unsigned /* next target */> TStackItem;
+    std::vector<TStackItem> dfsStack;
+    std::set<TBlock> seen;
 
-        // update self
-        BOOST_FOREACH(TVar uid, bDataSrc.gen) {
-            if (hasKey(bData.kill, uid))
-                // we are killing the variable
-                continue;
+    const TBlock entry = fnc.cfg.entry();
+    if (entry) {
+        seen.insert(entry);
+        dfsStack.push_back(TStackItem(entry, 0U));
+    }
+
+    while (!dfsStack.empty()) {
+        TStackItem &top = dfsStack.back();
+        const TBlock bb = top.first;
+        const TTargetList &targets = bb->targets();
+        if (top.second < targets.size()) {
+            const TBlock next = targets[top.second++];
+            if (insertOnce(seen, next))
+                dfsStack.push_back(TStackItem(next, 0U));
 
-            if (insertOnce(bData.gen, uid))
-                anyChange = true;
+            continue;
         }
+
+        idx.blocks.push_back(bb);
+        dfsStack.pop_back();
     }
 
-    if (!anyChange)
-        // nothing updated actually
-        return;
+    // unreachable blocks need to be analyzed, too
+    BOOST_FOREACH(const TBlock bb, fnc.cfg)
+        if (insertOnce(seen, bb))
+            idx.blocks.push_back(bb);
 
-    // schedule all predecessors
-    BOOST_FOREACH(TBlock bbDst, bb->inbound())
-        data.todo.insert(bbDst);
+    for (unsigned pos = 0U; pos < idx.blocks.size(); ++pos)
+        idx.posByBlock[idx.blocks[pos]] = pos;
 }
 
-void computeFixPoint(Data &data)
+void computeFixPoint(Data &data, const Fnc &fnc)
 {
-    // fixed-point computation
+    FncIndex idx;
+    indexFnc(idx, data, fnc);
+
+    const unsigned cntBlocks = idx.blocks.size();
+    std::vector<TBits> live(cntBlocks), kill(cntBlocks);
+    std::vector<std::vector<unsigned> > succs(cntBlocks), preds(cntBlocks);
+    for (unsigned pos = 0U; pos < cntBlocks; ++pos) {
+        const TBlock bb = idx.blocks[pos];
+        const BlockData &bData = data.blocks[bb];
+        live[pos] = idx.toBits(bData.gen);
+        kill[pos] = idx.toBits(bData.kill);
+
+        BOOST_FOREACH(TBlock bbSrc, bb->targets())
+            succs[pos].push_back(idx.posByBlock[bbSrc]);
+
+        BOOST_FOREACH(TBlock bbDst, bb->inbound())
+            preds[pos].push_back(idx.posByBlock[bbDst]);
+    }
+
+    // fixed-point computation, the blocks are visited in post-order, so that
+    // a single sweep suffices for an acyclic CFG
     unsigned cntSteps = 1;
-    TBlockSet &todo = data.todo;
-    while (!todo.empty()) {
-        TBlockSet::iterator i = todo.begin();
-        TBlock bb = *i;
-        todo.erase(i);
-
-        // (re)compute a single basic block
-        updateBlock(data, bb);
-        ++cntSteps;
+    std::vector<bool> todo(cntBlocks, true);
+    TBits next(idx.uidByIdx.size());
+    for (bool anyTodo = true; anyTodo;) {
+        anyTodo = false;
+
+        for (unsigned pos = 0U; pos < cntBlocks; ++pos) {
+            if (!todo[pos])
+                continue;
+
+            todo[pos] = false;
+            ++cntSteps;
+
+            // go through all variables generated by successors
+            next.reset();
+            BOOST_FOREACH(const unsigned src, succs[pos])
+                next |= live[src];
+
+            // we are killing some of the variables
+            next -= kill[pos];
+            next |= live[pos];
+
+            if (next == live[pos])
+                // nothing updated actually
+                continue;
+
+            live[pos].swap(next);
+
+            // schedule all predecessors
+            BOOST_FOREACH(const unsigned dst, preds[pos]) {
+                todo[dst] = true;
+                if (dst <= pos)
+                    // not to be reached by the current sweep
+                    anyTodo = true;
+            }
+        }
     }
 
     VK_DEBUG(2, "fixed-point reached in " << cntSteps << " steps");
+
+    // write the results back for commitBlock()
+    for (unsigned pos = 0U; pos < cntBlocks; ++pos)
+        idx.fromBits(data.blocks[idx.blocks[pos]].gen, live[pos]);
 }
 
 inline bool isPointedUid(Data &data, int uid)
@@ -600,7 +711,6 @@ void analyzeFnc(Fnc &fnc)
 
     TLoc loc = &fnc.def.data.cst.data.cst_fnc.loc;
     VK_DEBUG_MSG(2, loc, ">>> entering " << nameOf(fnc) << "()");
-    CL_BREAK_IF(!data.todo.empty());
 
     // pre-compute dereferences
     findAliases(data, fnc);
@@ -617,44 +727,57 @@ void analyzeFnc(Fnc &fnc)
 
         // guarantee to distribute pointer-targests exist when function finishes
         presetLive(data, bb);
-
-        data.todo.insert(bb);
     }
 
     // compute a fixed-point for a single function
     VK_DEBUG_MSG(2, loc, "computing fixed-point for " << nameOf(fnc) << "()");
-    computeFixPoint(data);
+    computeFixPoint(data, fnc);
 
     // commit the results
     BOOST_FOREACH(const TBlock bb, fnc.cfg) {
         VK_DEBUG_MSG(2, &bb->front()->loc, "commitBlock: " << bb->name());
         commitBlock(data, bb);
     }
+
+#if CL_PREPROCESS_THREADS
+    static std::mutex statsMutex;
+    std::lock_guard<std::mutex> guard(statsMutex);
+#endif
+    PTStats *stats = PTStats::getInstance();
+    stats->count        += data.cntPtKilled;
+    stats->fullCount    += data.cntKilled;
 }
 
 } // namespace VarKiller
 
-void killLocalVariables(Storage &stor)
+void killLocalVariables(Fnc &fnc)
 {
-    StopWatch watch;
-
-    // analyze all _defined_ functions
-    BOOST_FOREACH(Fnc *pFnc, stor.fncs) {
-        Fnc &fnc = *pFnc;
-        if (!isDefined(fnc))
-            continue;
-
-        // analyze a single function
-        VarKiller::analyzeFnc(fnc);
-    }
+    VarKiller::analyzeFnc(fnc);
+}
 
+void printVarKillerStats()
+{
     VarKiller::PTStats *stats = VarKiller::PTStats::getInstance();
     if (stats->count > 0) {
         VK_DEBUG(0, "there was killed " << stats->count 
                 << "/" << stats->fullCount << " variables by PointsTo");
     }
+}
+
+void killLocalVariables(Storage &stor)
+{
+    // each function is analyzed independently
+    TaskGraph tg;
+    const TaskGraph::TPassId pass =
+        tg.addPass("killLocalVariables", &printVarKillerStats);
+
+    // analyze all _defined_ functions
+    BOOST_FOREACH(Fnc *pFnc, stor.fncs) {
+        if (isDefined(*pFnc))
+            tg.addTask(pass, std::bind(&VarKiller::analyzeFnc, std::ref(*pFnc)));
+    }
 
-    CL_DEBUG("killLocalVariables() took " << watch);
+    tg.run();
 }
 
 } // namespace CodeStorage
@@ -26,9 +26,16 @@
  */
 
 namespace CodeStorage {
+    struct Fnc;
     struct Storage;
 
     void killLocalVariables(Storage &stor);
+
+    /// per-function part of killLocalVariables(), needs points-to info ready
+    void killLocalVariables(Fnc &fnc);
+
+    /// print the statistics collected by killLocalVariables() in verbose mode
+    void printVarKillerStats();
 }
 
 #endif /* H_GUARD_KILLER_H */
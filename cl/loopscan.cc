@@ -143,6 +143,11 @@ void analyzeFnc(Fnc &fnc)
 
 } // namespace LoopScan
 
+void findLoopClosingEdges(Fnc &fnc)
+{
+    LoopScan::analyzeFnc(fnc);
+}
+
 void findLoopClosingEdges(Storage &stor)
 {
     StopWatch watch;
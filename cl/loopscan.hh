@@ -26,9 +26,13 @@
  */
 
 namespace CodeStorage {
+    struct Fnc;
     struct Storage;
 
     void findLoopClosingEdges(Storage &stor);
+
+    /// per-function part of findLoopClosingEdges()
+    void findLoopClosingEdges(Fnc &fnc);
 }
 
 #endif /* H_GUARD_LOOPSCAN_H */
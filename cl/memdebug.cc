@@ -24,6 +24,24 @@
 
 #include <iomanip>
 
+#include <sys/resource.h>
+
+bool peakRssUsage(long *pDst)
+{
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage))
+        return false;
+
+#ifdef __APPLE__
+    // Darwin reports the amount in bytes
+    *pDst = usage.ru_maxrss >> 20;
+#else
+    // Linux reports the amount in KiB
+    *pDst = usage.ru_maxrss >> 10;
+#endif
+    return true;
+}
+
 #if DEBUG_MEM_USAGE
 #   include <malloc.h>
 
@@ -0,0 +1,373 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config_cl.h"
+
+#include <cl/cl_msg.hh>
+#include <cl/plotwriter.hh>
+
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <utility>
+
+#if CL_PLOT_WRITER_QUEUE
+#   include <condition_variable>
+#   include <deque>
+#   include <mutex>
+#   include <thread>
+#endif
+
+#include <boost/foreach.hpp>
+
+// /////////////////////////////////////////////////////////////////////////////
+// implementation of PlotRecord
+PlotRecord::TItem& PlotRecord::addItem(const EItemKind code)
+{
+    items_.push_back(TItem());
+    TItem &item = items_.back();
+    item.code = code;
+    item.fmt = 0;
+    return item;
+}
+
+PlotRecord& PlotRecord::addText(const char *str, const size_t len)
+{
+    text_.append(str, len);
+
+    if (items_.empty() || PI_TEXT != items_.back().code)
+        this->addItem(PI_TEXT).data.len = len;
+    else
+        // extend the text of the previous item
+        items_.back().data.len += len;
+
+    return *this;
+}
+
+PlotRecord& PlotRecord::addInt(const long long i)
+{
+    this->addItem(PI_INT).data.i = i;
+    return *this;
+}
+
+PlotRecord& PlotRecord::addUInt(const unsigned long long u)
+{
+    this->addItem(PI_UINT).data.u = u;
+    return *this;
+}
+
+PlotRecord& PlotRecord::operator<<(const char *str)
+{
+    return this->addText(str, strlen(str));
+}
+
+PlotRecord& PlotRecord::operator<<(const std::string &str)
+{
+    return this->addText(str.data(), str.size());
+}
+
+PlotRecord& PlotRecord::operator<<(const char c)
+{
+    return this->addText(&c, 1U);
+}
+
+PlotRecord& PlotRecord::operator<<(const int i)
+{
+    return this->addInt(i);
+}
+
+PlotRecord& PlotRecord::operator<<(const long i)
+{
+    return this->addInt(i);
+}
+
+PlotRecord& PlotRecord::operator<<(const long long i)
+{
+    return this->addInt(i);
+}
+
+PlotRecord& PlotRecord::operator<<(const unsigned u)
+{
+    return this->addUInt(u);
+}
+
+PlotRecord& PlotRecord::operator<<(const unsigned long u)
+{
+    return this->addUInt(u);
+}
+
+PlotRecord& PlotRecord::operator<<(const unsigned long long u)
+{
+    return this->addUInt(u);
+}
+
+PlotRecord& PlotRecord::operator<<(const double d)
+{
+    this->addItem(PI_REAL).data.d = d;
+    return *this;
+}
+
+PlotRecord& PlotRecord::operator<<(const void *ptr)
+{
+    this->addItem(PI_PTR).data.obj = ptr;
+    return *this;
+}
+
+PlotRecord& PlotRecord::operator<<(const PlotRef &ref)
+{
+    TItem &item = this->addItem(PI_REF);
+    item.fmt = ref.fmt;
+    item.data.obj = ref.obj;
+    return *this;
+}
+
+void PlotRecord::format(std::ostream &str)
+{
+    const char *text = text_.data();
+
+    BOOST_FOREACH(const TItem &item, items_) {
+        switch (item.code) {
+            case PI_TEXT:
+                str.write(text, item.data.len);
+                text += item.data.len;
+                break;
+
+            case PI_INT:
+                str << item.data.i;
+                break;
+
+            case PI_UINT:
+                str << item.data.u;
+                break;
+
+            case PI_REAL:
+                str << item.data.d;
+                break;
+
+            case PI_PTR:
+                str << item.data.obj;
+                break;
+
+            case PI_REF:
+                item.fmt(str, item.data.obj);
+                break;
+        }
+    }
+}
+
+// /////////////////////////////////////////////////////////////////////////////
+// implementation of writePlotFile() and flushPlotFiles()
+struct PlotFile {
+    FILE                               *out;
+    std::string                         fileName;
+};
+
+typedef std::pair<TPlotErrorHandler, std::string>   TError;
+typedef std::vector<TError>                         TErrorList;
+
+/// format the plot, write and close the file, append to errList on failure
+static void writeFile(
+        TErrorList                     *pErrList,
+        PlotFile                       *file,
+        IPlotJob                       *job,
+        const TPlotErrorHandler         handler)
+{
+    std::ostringstream str;
+    job->format(str);
+    delete job;
+
+    const std::string contents(str.str());
+    const size_t len = contents.size();
+    FILE *out = file->out;
+    bool ok = (len == fwrite(contents.data(), 1U, len, out));
+    ok &= !fclose(out);
+    if (!ok) {
+        const std::string msg("unable to write file '" + file->fileName + "'");
+        pErrList->push_back(TError(handler, msg));
+    }
+
+    delete file;
+}
+
+static bool reportErrors(const TErrorList &errList)
+{
+    BOOST_FOREACH(const TError &err, errList) {
+        const TPlotErrorHandler handler = err.first;
+        if (handler)
+            handler(err.second);
+        else
+            CL_ERROR(err.second);
+    }
+
+    return errList.empty();
+}
+
+#if CL_PLOT_WRITER_QUEUE
+class PlotWriter {
+    public:
+        PlotWriter():
+            busy_(false),
+            exiting_(false)
+        {
+        }
+
+        ~PlotWriter();
+
+        void enqueue(
+                TErrorList             *pErrList,
+                PlotFile               *file,
+                IPlotJob               *job,
+                TPlotErrorHandler       handler);
+
+        void flush(TErrorList *pErrList);
+
+    private:
+        struct TItem {
+            PlotFile                   *file;
+            IPlotJob                   *job;
+            TPlotErrorHandler           handler;
+        };
+
+        std::mutex                      mutex_;
+        std::condition_variable         cond_;
+        std::deque<TItem>               queue_;
+        TErrorList                      errList_;
+        std::thread                     thread_;
+        bool                            busy_;
+        bool                            exiting_;
+
+        void workerLoop();
+};
+
+PlotWriter::~PlotWriter()
+{
+    if (!thread_.joinable())
+        return;
+
+    // let the worker write the remainder of the queue and terminate
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        exiting_ = true;
+    }
+
+    cond_.notify_all();
+    thread_.join();
+}
+
+void PlotWriter::workerLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        if (queue_.empty()) {
+            if (exiting_)
+                break;
+
+            cond_.wait(lock);
+            continue;
+        }
+
+        const TItem item = queue_.front();
+        queue_.pop_front();
+
+        busy_ = true;
+        lock.unlock();
+
+        TErrorList errList;
+        writeFile(&errList, item.file, item.job, item.handler);
+
+        lock.lock();
+        busy_ = false;
+        errList_.insert(errList_.end(), errList.begin(), errList.end());
+
+        // there is a free slot in the queue now, or we are all done
+        cond_.notify_all();
+    }
+}
+
+void PlotWriter::enqueue(
+        TErrorList                     *pErrList,
+        PlotFile                       *file,
+        IPlotJob                       *job,
+        TPlotErrorHandler               handler)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!thread_.joinable())
+        // the first plot, start the worker
+        thread_ = std::thread(&PlotWriter::workerLoop, this);
+
+    while (CL_PLOT_WRITER_QUEUE <= queue_.size())
+        cond_.wait(lock);
+
+    const TItem item = { file, job, handler };
+    queue_.push_back(item);
+    cond_.notify_all();
+
+    // pick the failures of the plots written so far
+    pErrList->insert(pErrList->end(), errList_.begin(), errList_.end());
+    errList_.clear();
+}
+
+void PlotWriter::flush(TErrorList *pErrList)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (busy_ || !queue_.empty())
+        cond_.wait(lock);
+
+    pErrList->insert(pErrList->end(), errList_.begin(), errList_.end());
+    errList_.clear();
+}
+
+static PlotWriter plotWriter;
+#endif // CL_PLOT_WRITER_QUEUE
+
+PlotFile* createPlotFile(const std::string &fileName)
+{
+    FILE *out = fopen(fileName.c_str(), "w");
+    if (!out)
+        return 0;
+
+    PlotFile *file = new PlotFile;
+    file->out = out;
+    file->fileName = fileName;
+    return file;
+}
+
+bool writePlotFile(
+        PlotFile                       *file,
+        IPlotJob                       *job,
+        TPlotErrorHandler               handler)
+{
+    TErrorList errList;
+#if CL_PLOT_WRITER_QUEUE
+    // the write failures we learn about here come from the plots queued before
+    plotWriter.enqueue(&errList, file, job, handler);
+#else
+    writeFile(&errList, file, job, handler);
+#endif
+    return reportErrors(errList);
+}
+
+bool flushPlotFiles()
+{
+    TErrorList errList;
+#if CL_PLOT_WRITER_QUEUE
+    plotWriter.flush(&errList);
+#endif
+    return reportErrors(errList);
+}
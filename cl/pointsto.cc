@@ -20,7 +20,6 @@
 #include "config_cl.h"
 
 #include "util.hh"
-#include "stopwatch.hh"
 #include "builtins.hh"
 
 #include "pointsto.hh"
@@ -64,12 +63,18 @@ bool bindVarList(
         BuildCtx                       &ctx,
         Graph                          &ptg,
         Node                           *target,
-        const TItemList                &nl)
+        const TItemList                &nl,
+        size_t                          first)
 {
     CL_BREAK_IF(existsError(ctx.stor));
 
     bool changed = false;
-    BOOST_FOREACH(const Item *i, nl) {
+    for (size_t idx = first; idx < nl.size(); ++idx) {
+        const Item *i = nl[idx];
+
+        // the target may have been joined into another node meanwhile
+        target = findRepS(target);
+
         if (!hasKey(ptg.map, i->uid())) {
             // this variable is still not in target graph
             bindItem(ptg, target, i);
@@ -111,7 +116,7 @@ Node *preventEndingS(Node *node)
 // assign or move Item into node within graph
 void bindItem(Graph &ptg, Node *n, const Item *i)
 {
-    CL_BREAK_IF(!n || !i);
+    CL_BREAK_IF(!n || !i || n->joinedTo);
 
     int uid = i->uid();
 
@@ -128,6 +133,22 @@ void bindItem(Graph &ptg, Node *n, const Item *i)
         ptg.uidToItem[uid] = i;
 }
 
+Node *findRepS(Node *node)
+{
+    Node *rep = node;
+    while (rep->joinedTo)
+        rep = rep->joinedTo;
+
+    // path compression
+    while (node != rep) {
+        Node *next = node->joinedTo;
+        node->joinedTo = rep;
+        node = next;
+    }
+
+    return rep;
+}
+
 void joinFixPointS(BuildCtx &ctx, Graph &ptg)
 {
     CL_BREAK_IF(existsError(ctx.stor));
@@ -138,7 +159,8 @@ void joinFixPointS(BuildCtx &ctx, Graph &ptg)
         TNodePair pair = todo.back();
         todo.pop_back();
 
-        joinNodesS(ctx, ptg, pair.first, pair.second);
+        // the nodes of the pair may have been joined by the preceding pairs
+        joinNodesS(ctx, ptg, findRepS(pair.first), findRepS(pair.second));
         changed = true;
     }
 
@@ -154,11 +176,14 @@ void joinNodesS(
         Node                           *nodeRight)
 {
     CL_BREAK_IF(existsError(ctx.stor));
+    CL_BREAK_IF(nodeLeft->joinedTo || nodeRight->joinedTo);
 
     if (nodeLeft == nodeRight)
         // just skip -- do not fail
         return;
 
+    ++ctx.stats.joins;
+
     BOOST_FOREACH(const Item *i, nodeRight->variables)
         // re-map nodeB's variables to nodeA
         bindItem(ptg, nodeLeft, i);
@@ -181,13 +206,9 @@ void joinNodesS(
     }
     CL_BREAK_IF(nodeRight->outNodes.size() > 0);
 
-    // FIXME: this causes a USE_AFTER_FREE in bindVarList() on the line where
-    //        we check hasKey(target->variables, i) in case we are called from
-    //        there via joinFixPointS(), see tests/predator-regre/test-0701.c
-    //        (attach_buffer_insert_head_list.c from SLAyer) for a reproducer
-#if 0
-    delete nodeRight;
-#endif
+    // nodeRight is not deleted, it is kept as a forwarder to nodeLeft since
+    // it may still be referenced by ctx.joinTodo or by our callers
+    nodeRight->joinedTo = nodeLeft;
 
     // the graph should be OK again
     CL_BREAK_IF(existsError(ctx.stor));
@@ -651,27 +672,70 @@ bool existsError(const Storage &stor)
     return false;
 }
 
+/**
+ * count the (live) nodes and the items of the given graph
+ */
+void countGraphS(int *pNodes, int *pItems, const Graph &g)
+{
+    WorkList<const Node *> wl;
+    BOOST_FOREACH(TMap::const_reference pair, g.map)
+        wl.schedule(pair.second);
+
+    const Node *node;
+    while (wl.next(node)) {
+        ++(*pNodes);
+
+        const Node *outNode = hasOutputS(node);
+        if (outNode)
+            wl.schedule(outNode);
+    }
+
+    *pItems += g.map.size();
+}
+
+void printStats(const BuildCtx &ctx)
+{
+    if (pt_dbg_level < 1)
+        // counting the graph nodes is not for free, skip it if not printed
+        return;
+
+    int cntGraphs = 1;
+    int cntNodes = 0;
+    int cntItems = 0;
+    countGraphS(&cntNodes, &cntItems, ctx.stor.ptd.gptg);
+    BOOST_FOREACH(const Fnc *fnc, ctx.stor.fncs) {
+        if (fnc->ptg.map.empty())
+            continue;
+
+        ++cntGraphs;
+        countGraphS(&cntNodes, &cntItems, fnc->ptg);
+    }
+
+    PT_DEBUG(1, cntGraphs << " graphs with " << cntNodes << " nodes and "
+            << cntItems << " items built using " << ctx.stats.joins
+            << " joins, " << ctx.stats.itemsSkipped
+            << " items skipped by difference propagation");
+}
+
 } /* namespace PointsTo */
 
 void pointsToAnalyse(Storage &stor, const std::string &conf)
 {
-    StopWatch watch;
-
     PointsTo::BuildCtx ctx(stor);
     ptParseOpts(ctx, conf.c_str());
 
     if (stor.callGraph.hasCallback || stor.callGraph.hasIndirectCall) {
         stor.ptd.dead = true;
         PT_ERROR("points-to analyse requires correct call graph");
-        goto done;
+        return;
     }
     // FICS only for now
     if (!PointsTo::runFICS(ctx)) {
         stor.ptd.dead = true;
+        return;
     }
 
-done:
-    CL_DEBUG("pointsToAnalyse() took " << watch);
+    PointsTo::printStats(ctx);
 }
 
 } // namespace CodeStorage
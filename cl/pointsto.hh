@@ -26,6 +26,9 @@
 #include <cl/cl_msg.hh>
 #include <cl/cldebug.hh>
 
+#include <cstring>
+#include <map>
+
 extern int pt_dbg_level;
 
 #define PT_DEBUG(level, ...) do {                                           \
@@ -42,6 +45,11 @@ namespace PointsTo {
     typedef std::pair<Node*, Node*>     TNodePair;
     typedef std::vector<TNodePair>      TNodeJoinTodo;
 
+    // source and target node of bindLocations() and the count of items of the
+    // source node already bound into the target node
+    typedef std::pair<const Node *, const Node *>       TNodeBound;
+    typedef std::map<TNodeBound, size_t>                TBoundMap;
+
 // TODO: incorporate this in parameter parsing to allow easily turn some of the
 // FICS phases off
 #define FICS_PHASE_1 0x01
@@ -69,12 +77,21 @@ namespace PointsTo {
                 int phases;
             } debug;
 
+            // items already bound by bindLocations(), see bindVarList()
+            TBoundMap                   bound;
+
+            struct stats {
+                int                     joins;
+                int                     itemsSkipped;
+            } stats;
+
             BuildCtx(Storage &stor_) :
                 stor(stor_),
                 ptg(NULL)
             {
                 plot.progress = NULL; // disable by default
                 debug.phases = FICS_PHASE_1 | FICS_PHASE_2 | FICS_PHASE_3;
+                memset(&stats, 0, sizeof stats);
             }
     };
 
@@ -96,9 +113,18 @@ namespace PointsTo {
             Node                       *nodeA,
             Node                       *nodeB);
 
+    /**
+     * Return the node the given node has been (transitively) joined into, or
+     * the node itself if it has not been joined.  The joined nodes are kept as
+     * forwarders (union-find with path compression), so that the pointers held
+     * by ctx.joinTodo and the like remain valid.
+     */
+    Node *findRepS(Node *node);
+
     /**
      * Start the merging of nodes based on ctx.joinTodo information.  This
-     * function uses joinNodesS() internally.
+     * function uses joinNodesS() internally.  The nodes of the pairs being
+     * joined are translated by findRepS() first.
      */
     void joinFixPointS(
             BuildCtx                   &ctx,
@@ -172,12 +198,16 @@ namespace PointsTo {
      * assigns some variable item to the node it checks whether this item does
      * not already exist somewhere else in target graph.  If yes, it performs
      * joining (joinFixPointS()) with the concurrent node.
+     *
+     * @param first index of the first item of nl to bind, the preceding items
+     * are known to be bound into target already
      */
     bool bindVarList(
             BuildCtx                   &ctx,
             Graph                      &ptg,
             Node                       *target,
-            const TItemList            &nl);
+            const TItemList            &nl,
+            size_t                      first = 0);
 
     /**
      * return true if some variable (lhs) follows another one (rhs)
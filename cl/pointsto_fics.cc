@@ -20,6 +20,7 @@
 #include "util.hh"
 #include "worklist.hh"
 #include "builtins.hh"
+#include "stopwatch.hh"
 
 #include <cl/clutil.hh>
 #include <cl/storage.hh>
@@ -1067,7 +1068,16 @@ bool bindLocations(
         const Node *srcNode;
         for (int depth = 0; wl.next(srcNode); depth++) {
             Node *dstNode = goDownS(tgtNode, depth + 1);
-            if (bindVarList(ctx, *tgtPtg, dstNode, srcNode->variables))
+
+            // difference propagation -- the items are only appended to nodes,
+            // so we need to bind just those added since the last visit
+            const TItemList &items = srcNode->variables;
+            size_t &bound = ctx.bound[TNodeBound(srcNode, dstNode)];
+            ctx.stats.itemsSkipped += bound;
+            const size_t first = bound;
+            bound = items.size();
+
+            if (bindVarList(ctx, *tgtPtg, dstNode, items, first))
                 change = true;
             CL_BREAK_IF(existsError(ctx.stor));
 
@@ -1288,10 +1298,20 @@ fallback:
     return false;
 }
 
+bool runPhase(BuildCtx &ctx, bool (*phase)(BuildCtx &), const char *name)
+{
+    StopWatch watch;
+    const bool ok = phase(ctx);
+    PT_DEBUG(1, name << "() took " << watch);
+    return ok;
+}
+
 bool runFICS(BuildCtx &ctx)
 {
     // all phases should success to provide correct points-to graph
-    return ficsPhase1(ctx) && ficsPhase2(ctx) && ficsPhase3(ctx);
+    return runPhase(ctx, ficsPhase1, "ficsPhase1")
+        && runPhase(ctx, ficsPhase2, "ficsPhase2")
+        && runPhase(ctx, ficsPhase3, "ficsPhase3");
 }
 
 } /* namespace PointsTo */
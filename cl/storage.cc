@@ -25,8 +25,11 @@
 #include "cl_storage.hh"
 #include "util.hh"
 
+#include <algorithm>
+#include <cstring>
 #include <map>
 #include <stack>
+#include <vector>
 
 #include <boost/foreach.hpp>
 #include <boost/tuple/tuple.hpp>
@@ -34,6 +37,102 @@
 namespace CodeStorage {
 
 namespace {
+    /**
+     * lookup table indexed by uid, the table is indexed directly as long as
+     * the uids are dense enough, std::map is used as a fallback otherwise
+     * @note This mimics the part of std::map interface used by dbLookup().
+     */
+    template <typename TVal>
+    class UidMap {
+        public:
+            typedef std::pair<int, TVal>                value_type;
+            typedef value_type                         *iterator;
+            typedef const value_type                   *const_iterator;
+
+        public:
+            UidMap():
+                cnt_(0U)
+            {
+            }
+
+            iterator end()                  { return 0; }
+            const_iterator end() const      { return 0; }
+
+            iterator find(const int uid) {
+                const UidMap &self = *this;
+                return const_cast<iterator>(self.find(uid));
+            }
+
+            const_iterator find(const int uid) const;
+
+            TVal& operator[](const int uid);
+
+        private:
+            /// uids below this bound are always indexed directly
+            static const unsigned DENSE_SLACK = 0x400;
+
+            typedef std::vector<value_type>             TDense;
+            typedef std::map<int, value_type>           TSparse;
+
+            unsigned                                    cnt_;
+            TDense                                      dense_;
+            TSparse                                     sparse_;
+    };
+
+    template <typename TVal>
+    typename UidMap<TVal>::const_iterator
+    UidMap<TVal>::find(const int uid) const
+    {
+        if (0 <= uid && static_cast<unsigned>(uid) < dense_.size()) {
+            const value_type &slot = dense_[uid];
+            if (uid == slot.first)
+                return &slot;
+        }
+
+        if (sparse_.empty())
+            return 0;
+
+        const typename TSparse::const_iterator it = sparse_.find(uid);
+        return (sparse_.end() == it)
+            ? 0
+            : &it->second;
+    }
+
+    template <typename TVal>
+    TVal& UidMap<TVal>::operator[](const int uid)
+    {
+        if (!sparse_.empty()) {
+            // the uid may have been stored before the table got large enough
+            const typename TSparse::iterator it = sparse_.find(uid);
+            if (sparse_.end() != it)
+                return it->second.second;
+        }
+
+        const unsigned idx = static_cast<unsigned>(uid);
+        if (uid < 0 || (dense_.size() <= idx && DENSE_SLACK + 2U * cnt_ <= idx)) {
+            // the uid is too far, use the fallback
+            value_type &item = sparse_[uid];
+            item.first = uid;
+            ++cnt_;
+            return item.second;
+        }
+
+        if (dense_.size() <= idx) {
+            const unsigned size = std::max<unsigned>(idx + 1U, 2U * dense_.size());
+            // negative uids are never stored directly, -1 marks unused slots
+            dense_.resize(size, value_type(-1, TVal()));
+        }
+
+        value_type &slot = dense_[idx];
+        if (uid != slot.first) {
+            // a newly inserted uid
+            slot.first = uid;
+            ++cnt_;
+        }
+
+        return slot.second;
+    }
+
     /**
      * Look for an existing value, create a new one if not found.
      * @param db Mapping from key to index.
@@ -159,7 +258,7 @@ bool isOnStack(const Var &var)
 // /////////////////////////////////////////////////////////////////////////////
 // VarDb implementation
 struct VarDb::Private {
-    typedef std::map<int, unsigned> TMap;
+    typedef UidMap<unsigned> TMap;
     TMap db;
 };
 
@@ -191,7 +290,7 @@ const Var& VarDb::operator[](int uid) const
 // /////////////////////////////////////////////////////////////////////////////
 // TypeDb implementation
 struct TypeDb::Private {
-    typedef std::map<int, const struct cl_type *> TMap;
+    typedef UidMap<const struct cl_type *> TMap;
     TMap db;
 
     int codePtrSizeof;
@@ -464,7 +563,8 @@ const Var *Item::var() const
 }
 
 Node::Node():
-    isBlackHole(false)
+    isBlackHole(false),
+    joinedTo(0)
 {
 }
 
@@ -558,6 +658,15 @@ int uidOf(const Fnc &fnc)
     return cst.data.cst_fnc.uid;
 }
 
+bool FncUidLess::operator()(const Fnc *a, const Fnc *b) const
+{
+    if (!a || !b)
+        // zero key means an indirect call or a var initializer
+        return !a && b;
+
+    return uidOf(*a) < uidOf(*b);
+}
+
 bool isDefined(const Fnc &fnc)
 {
     return CL_OPERAND_CST == fnc.def.code
@@ -567,7 +676,7 @@ bool isDefined(const Fnc &fnc)
 // /////////////////////////////////////////////////////////////////////////////
 // FncDb implementation
 struct FncDb::Private {
-    typedef std::map<int, unsigned> TMap;
+    typedef UidMap<unsigned> TMap;
     TMap db;
 };
 
@@ -610,6 +719,83 @@ const Fnc* FncDb::operator[](int uid) const
     return dbConstLookup(d->db, fncs_, uid);
 }
 
+
+// /////////////////////////////////////////////////////////////////////////////
+// Arena implementation
+struct Arena::Private {
+    std::vector<char *>         chunks;
+    char                       *next;
+    size_t                      avail;
+    size_t                      total;
+
+    Private():
+        next(0),
+        avail(0U),
+        total(0U)
+    {
+    }
+
+    char* newChunk(size_t size) {
+        char *chunk = new char[size];
+        this->chunks.push_back(chunk);
+        this->total += size;
+        return chunk;
+    }
+};
+
+Arena::Arena():
+    d(new Private)
+{
+}
+
+Arena::~Arena()
+{
+    BOOST_FOREACH(char *chunk, d->chunks)
+        delete[] chunk;
+
+    delete d;
+}
+
+void* Arena::alloc(size_t size)
+{
+    static const size_t align = 2 * sizeof(void *);
+    static const size_t chunkSize = 0x10000;
+
+    // round the size up to keep all the blocks aligned
+    size = (size + align - 1) & ~(align - 1);
+
+    if (chunkSize / 4 < size)
+        // too big to share a chunk with others
+        return d->newChunk(size);
+
+    if (d->avail < size) {
+        // the rest of the current chunk is wasted
+        d->next = d->newChunk(chunkSize);
+        d->avail = chunkSize;
+    }
+
+    void *ptr = d->next;
+    d->next += size;
+    d->avail -= size;
+    return ptr;
+}
+
+const char* Arena::dupString(const char *str)
+{
+    if (!str)
+        return 0;
+
+    const size_t size = strlen(str) + 1;
+    char *dst = static_cast<char *>(this->alloc(size));
+    memcpy(dst, str, size);
+    return dst;
+}
+
+size_t Arena::size() const
+{
+    return d->total;
+}
+
 const Fnc* fncByCfg(const ControlFlow *pCfg)
 {
     const char *ptr = reinterpret_cast<const char *>(pCfg);
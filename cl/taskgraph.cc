@@ -0,0 +1,269 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config_cl.h"
+#include "taskgraph.hh"
+
+#include <cl/cl_msg.hh>
+#include <cl/memdebug.hh>
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+#if CL_PREPROCESS_THREADS
+#   include <condition_variable>
+#   include <mutex>
+#   include <thread>
+#endif
+
+#include <boost/foreach.hpp>
+
+typedef std::chrono::steady_clock                   TClock;
+
+struct TaskGraph::Private {
+    struct Pass {
+        std::string                 name;
+        TTask                       onDone;
+        std::vector<TTask>          tasks;
+        std::vector<TPassId>        dependants;
+        unsigned                    cntDeps;
+        unsigned                    cntPending;
+        TClock::time_point          started;
+
+        Pass(const char *name_, const TTask &onDone_):
+            name((name_) ? name_ : ""),
+            onDone(onDone_),
+            cntDeps(0U),
+            cntPending(0U)
+        {
+        }
+    };
+
+    typedef std::pair<TPassId, unsigned /* task idx */> TReadyItem;
+
+    std::vector<Pass>               passes;
+    std::deque<TReadyItem>          ready;
+
+    /// passes with all tasks done, but not yet reported and released
+    std::vector<TPassId>            done;
+    unsigned                        cntFinished;
+
+#if CL_PREPROCESS_THREADS
+    std::mutex                      mutex;
+    std::condition_variable         cond;
+    unsigned                        cntRunning;
+
+    void workerLoop();
+#endif
+
+    Private():
+        cntFinished(0U)
+#if CL_PREPROCESS_THREADS
+        , cntRunning(0U)
+#endif
+    {
+    }
+
+    void activate(TPassId);
+    void report(TPassId);
+    void release(TPassId);
+    void taskDone(TPassId);
+};
+
+TaskGraph::TaskGraph():
+    d(new Private)
+{
+}
+
+TaskGraph::~TaskGraph()
+{
+    delete d;
+}
+
+TaskGraph::TPassId TaskGraph::addPass(const char *name, TTask onDone)
+{
+    const TPassId id = d->passes.size();
+    d->passes.push_back(Private::Pass(name, onDone));
+    return id;
+}
+
+void TaskGraph::addDep(TPassId pass, TPassId dep)
+{
+    CL_BREAK_IF(dep == pass);
+    d->passes[dep].dependants.push_back(pass);
+    d->passes[pass].cntDeps++;
+}
+
+void TaskGraph::addTask(TPassId pass, TTask task)
+{
+    d->passes[pass].tasks.push_back(task);
+}
+
+void TaskGraph::Private::activate(const TPassId id)
+{
+    Pass &pass = this->passes[id];
+    pass.started = TClock::now();
+
+    const unsigned cnt = pass.tasks.size();
+    pass.cntPending = cnt;
+    if (!cnt) {
+        // nothing to wait for
+        this->done.push_back(id);
+        return;
+    }
+
+    for (unsigned i = 0U; i < cnt; ++i)
+        this->ready.push_back(TReadyItem(id, i));
+}
+
+/// run the call-back of a finished pass and report it, called without the lock
+void TaskGraph::Private::report(const TPassId id)
+{
+    Pass &pass = this->passes[id];
+    if (pass.onDone)
+        pass.onDone();
+
+    if (pass.name.empty())
+        return;
+
+    // wall-clock time, CPU time would include the work of the other threads
+    const std::chrono::duration<double> elapsed = TClock::now() - pass.started;
+    CL_DEBUG(pass.name << "() took " << std::fixed << std::setprecision(3)
+            << elapsed.count() << " s");
+
+    printMemUsage(pass.name.c_str());
+}
+
+/// mark a reported pass as finished and activate the passes waiting for it
+void TaskGraph::Private::release(const TPassId id)
+{
+    Pass &pass = this->passes[id];
+    ++this->cntFinished;
+
+    // release the memory occupied by the tasks, they will not be used again
+    std::vector<TTask>().swap(pass.tasks);
+
+    BOOST_FOREACH(const TPassId dep, pass.dependants)
+        if (!--this->passes[dep].cntDeps)
+            this->activate(dep);
+}
+
+void TaskGraph::Private::taskDone(const TPassId id)
+{
+    if (!--this->passes[id].cntPending)
+        this->done.push_back(id);
+}
+
+#if CL_PREPROCESS_THREADS
+void TaskGraph::Private::workerLoop()
+{
+    std::unique_lock<std::mutex> lock(this->mutex);
+    for (;;) {
+        if (!this->done.empty()) {
+            const TPassId id = this->done.back();
+            this->done.pop_back();
+
+            // the call-back and messages must not run under the lock
+            ++this->cntRunning;
+            lock.unlock();
+            this->report(id);
+            lock.lock();
+            --this->cntRunning;
+
+            this->release(id);
+            this->cond.notify_all();
+            continue;
+        }
+
+        if (this->ready.empty()) {
+            if (!this->cntRunning)
+                // nothing to wait for
+                break;
+
+            this->cond.wait(lock);
+            continue;
+        }
+
+        const TReadyItem item = this->ready.front();
+        this->ready.pop_front();
+        const TTask task = this->passes[item.first].tasks[item.second];
+
+        ++this->cntRunning;
+        lock.unlock();
+        task();
+        lock.lock();
+        --this->cntRunning;
+
+        this->taskDone(item.first);
+
+        // new tasks may have become ready, or we are all done
+        this->cond.notify_all();
+    }
+}
+#endif
+
+void TaskGraph::run()
+{
+    for (unsigned id = 0U; id < d->passes.size(); ++id)
+        if (!d->passes[id].cntDeps)
+            d->activate(id);
+
+#if CL_PREPROCESS_THREADS
+    // do not start more threads than the hardware can run at a time
+    const unsigned cntHw = std::thread::hardware_concurrency();
+    const unsigned cntThreads = (cntHw)
+        ? std::min<unsigned>(cntHw, CL_PREPROCESS_THREADS)
+        : CL_PREPROCESS_THREADS;
+
+    std::vector<std::thread> threads;
+    for (unsigned i = 1U; i < cntThreads; ++i)
+        threads.push_back(std::thread(&Private::workerLoop, d));
+
+    // the current thread participates, too
+    d->workerLoop();
+
+    BOOST_FOREACH(std::thread &t, threads)
+        t.join();
+#else
+    for (;;) {
+        if (!d->done.empty()) {
+            const TPassId id = d->done.back();
+            d->done.pop_back();
+            d->report(id);
+            d->release(id);
+            continue;
+        }
+
+        if (d->ready.empty())
+            break;
+
+        const Private::TReadyItem item = d->ready.front();
+        d->ready.pop_front();
+        d->passes[item.first].tasks[item.second]();
+        d->taskDone(item.first);
+    }
+#endif
+
+    // a dependency cycle would leave some of the passes unfinished
+    CL_BREAK_IF(d->passes.size() != d->cntFinished);
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef H_GUARD_TASKGRAPH_H
+#define H_GUARD_TASKGRAPH_H
+
+/**
+ * @file taskgraph.hh
+ * TaskGraph - runs passes, split into independent tasks, respecting the
+ * dependencies among the passes
+ */
+
+#include <functional>
+
+/**
+ * A pass consists of tasks that may run in any order (and in parallel if
+ * CL_PREPROCESS_THREADS is set in config_cl.h).  The tasks of a pass are not
+ * started before all passes it depends on are finished.  The wall-clock time
+ * taken by each pass (since its first task was started until its last task
+ * finished) is printed by CL_DEBUG once the pass is finished, followed by the
+ * memory usage.
+ * The call-backs and messages are issued without holding any internal lock.
+ */
+class TaskGraph {
+    public:
+        typedef std::function<void ()>              TTask;
+        typedef int                                 TPassId;
+
+    public:
+        TaskGraph();
+        ~TaskGraph();
+
+        /**
+         * declare a new pass
+         * @param name name of the pass, used to report the time taken and the
+         * memory usage (if the name is NULL, nothing is reported)
+         * @param onDone optional call-back invoked once all tasks are done
+         */
+        TPassId addPass(const char *name, TTask onDone = TTask());
+
+        /// tasks of the pass @b pass are started after the pass @b dep finishes
+        void addDep(TPassId pass, TPassId dep);
+
+        /// append a task to the given pass
+        void addTask(TPassId pass, TTask task);
+
+        /// run all the passes, returns when all of them are finished
+        void run();
+
+    private:
+        // not copyable
+        TaskGraph(const TaskGraph &);
+        TaskGraph& operator=(const TaskGraph &);
+
+        struct Private;
+        Private *d;
+};
+
+#endif /* H_GUARD_TASKGRAPH_H */
@@ -24,6 +24,28 @@
 #include "forestautext.hh"
 #include "streams.hh"
 
+/**
+ * @brief  Matches transitions of nodes with the same tag
+ *
+ * The functor used for the finite height abstraction: transitions of nodes
+ * match if the nodes have the same tag, other transitions match only if they
+ * have the same label.
+ */
+struct SmartTMatchF
+{
+	bool operator()(
+		const TT<label_type>&              t1,
+		const TT<label_type>&              t2)
+	{
+		if (t1.label()->isNode() && t2.label()->isNode())
+		{
+			return t1.label()->getTag() == t2.label()->getTag();
+		}
+
+		return t1.label() == t2.label();
+	}
+};
+
 /**
  * @brief  The class that performs abstraction
  *
@@ -29,73 +29,57 @@ class AntichainExt : public Antichain
 {
 protected:
 
-	typedef std::vector<const typename TA<T>::TransIDPair*> trans_list_type;
+	/// a transition of A or B with the states renumbered as in Antichain
+	struct TransInfo
+	{
+		const T*                   label;
+		std::vector<size_t>        lhs;
+		size_t                     rhs;
 
-private:
+		TransInfo() :
+			label{},
+			lhs{},
+			rhs{}
+		{ }
+	};
 
-	std::vector<std::vector<trans_list_type>> aTransIndex;
+	typedef std::vector<const TransInfo*> trans_list_type;
 
-	void simInsert(
-		std::pair<size_t, std::set<size_t>>&   el,
-		bool&                                  isAccepting,
-		size_t                                 rhs,
-		const TA<T>&                           aut)
-	{
-		// minimization
-		for (size_t i : this->relIndex[rhs])
-		{
-			if (el.second.find(i) != el.second.end())
-				return;
-		}
-
-		for (size_t i : this->invRelIndex[rhs])
-		{
-			el.second.erase(i);
-		}
+private:
 
-		el.second.insert(rhs);
-		isAccepting = isAccepting && !aut.isFinalState(rhs);
-	}
+	std::vector<std::vector<trans_list_type>> aTransIndex;
 
 public:
 
 	void aAddTransition(
-		const typename TA<T>::TransIDPair*   t,
+		const TransInfo*                     t,
 		size_t                               bSize)
 	{
-		std::unordered_set<size_t> s;
-		for (size_t i = 0; i < t->first.lhs().size(); ++i)
+		for (size_t i = 0; i < t->lhs.size(); ++i)
 		{
-			if (s.insert(t->first.lhs()[i]).second)
-			{
-				if (this->aTransIndex[t->first.lhs()[i] - bSize].size() < i + 1)
-					this->aTransIndex[t->first.lhs()[i] - bSize].resize(i + 1);
-				this->aTransIndex[t->first.lhs()[i] - bSize][i].push_back(t);
-			}
-		}
-	}
+			const size_t q = t->lhs[i];
+			if (std::find(t->lhs.begin(), t->lhs.begin() + i, q) != t->lhs.begin() + i)
+				// indexed by the first occurrence only
+				continue;
 
-	void finalizeTransitions()
-	{
-		for (typename std::vector<std::vector<trans_list_type>>::iterator i = this->aTransIndex.begin(); i != this->aTransIndex.end(); ++i)
-		{
-			for (typename std::vector<trans_list_type>::iterator j = i->begin(); j != i->end(); ++j)
-				utils::unique(*j, trans_list_type(*j));
+			if (this->aTransIndex[q - bSize].size() < i + 1)
+				this->aTransIndex[q - bSize].resize(i + 1);
+			this->aTransIndex[q - bSize][i].push_back(t);
 		}
 	}
 
 public:
 
-	AntichainExt(const std::vector<std::vector<bool> >& rel) :
-		Antichain(rel),
-		aTransIndex{}
+	/**
+	 * @brief  The constructor
+	 *
+	 * @param[in]  aSize  the number of states of A
+	 */
+	AntichainExt(size_t aSize) :
+		Antichain(),
+		aTransIndex(aSize)
 	{ }
 
-	void initIndex(size_t aSize, size_t /* bSize */)
-	{
-		this->aTransIndex.resize(aSize);
-	}
-
 	std::vector<trans_list_type>& getATrans(size_t q, size_t bSize)
 	{
 		return this->aTransIndex[q - bSize];
@@ -136,12 +120,12 @@ public:
 
 		bool get(
 			const std::pair<size_t, state_cache_type::value_type*>&   el,
-			const typename TA<T>::TransIDPair*                        t,
+			const TransInfo*                                          t,
 			size_t                                                    index)
 		{
 			this->state.clear();
 			this->fixed.front() = el.second;
-			for (size_t i = 0; i < t->first.lhs().size(); ++i)
+			for (size_t i = 0; i < t->lhs.size(); ++i)
 			{
 				State state;
 				if (i == index)
@@ -149,7 +133,7 @@ public:
 					state.trans = &this->fixed;
 				} else
 				{
-					antichain_type::iterator j = ac.processed.find(t->first.lhs()[i]);
+					antichain_type::iterator j = ac.processed.find(t->lhs[i]);
 					if (j == ac.processed.end())
 						return false;
 					state.trans = &j->second;
@@ -170,91 +154,80 @@ public:
 			return false;
 		}
 
-		bool match(const typename TA<T>::TransIDPair* t)
+		bool match(const TransInfo* t)
 		{
-			for (size_t i = 0; i < t->first.lhs().size(); ++i)
+			for (size_t i = 0; i < t->lhs.size(); ++i)
 			{
-				if ((*this->state[i].current)->first.count(t->first.lhs()[i]) == 0)
+				if (!(*this->state[i].current)->first.test(t->lhs[i]))
 					return false;
 			}
 			return true;
 		}
 	};
 
-	static bool subseteq(const TA<T>& a, const TA<T>& b)
+	/**
+	 * @brief  Checks whether each tree having a run in @p a has one in @p b
+	 *
+	 * The states of @p a and @p b are renumbered into a common range on the fly,
+	 * so no union of the automata is built.
+	 *
+	 * @note  Final states play no role here, only the sets of trees having a run
+	 *        in @p a and @p b are compared.
+	 */
+	static bool subseteq(
+		const TA<T>&                               a,
+		const TA<T>&                               b)
 	{
-		typename TA<T>::Backend backend;
-		TA<T> c(backend);
-		size_t countB;
-		TA<T>::renamedUnion(c, b, a, countB);
-		Index<size_t> stateIndex;
-		c.buildStateIndex(stateIndex);
-		size_t cSize = stateIndex.size();
-		stateIndex.clear();
-		for (size_t i = 0; i < cSize; ++i)
-			stateIndex.add(i);
-		// compute simulation
-		std::vector<std::vector<bool>> upsim, dwnsim, ident(cSize, std::vector<bool>(cSize, false));
-		for (size_t i = 0; i < cSize; ++i)
-		{
-			ident[i][i] = true;
-		}
+		Index<size_t> bIndex, aIndex;
+		b.buildStateIndex(bIndex);
+		a.buildStateIndex(aIndex);
+		const size_t countB = bIndex.size();
+
+		std::vector<TransInfo> bInfo, aInfo;
+		translate(bInfo, b, bIndex, 0);
+		translate(aInfo, a, aIndex, countB);
 
-		upsim = ident;
-		std::vector<std::vector<size_t> > upsimIndex;
-		utils::relIndex(upsimIndex, upsim);
-		AntichainExt<T> antichain(upsim);
+		AntichainExt<T> antichain(aIndex.size());
 		typename AntichainExt<T>::ResponseExt response(antichain);
-		antichain.initIndex(cSize - countB, countB);
 		trans_list_type aLeaves;
 		std::unordered_map<T, trans_list_type> bTrans, bLeaves;
-		for (typename TA<T>::trans_set_type::const_iterator i = c.transitions.begin(); i != c.transitions.end(); ++i)
+		for (const TransInfo& t : aInfo)
 		{
-			size_t arity = (*i)->first.lhs().size();
-			if ((*i)->first.rhs() >= countB)
+			if (t.lhs.empty())
 			{
-				if (arity == 0)
-				{
-					aLeaves.push_back(*i);
-				} else
-				{
-					antichain.aAddTransition(*i, countB);
-				}
+				aLeaves.push_back(&t);
 			} else
 			{
-				if (arity == 0)
-				{
-					bLeaves.insert(make_pair((*i)->first.label(), trans_list_type())).first->second.push_back(*i);
-				} else
-				{
-					bTrans.insert(make_pair((*i)->first.label(), trans_list_type())).first->second.push_back(*i);
-				}
+				antichain.aAddTransition(&t, countB);
+			}
+		}
+		for (const TransInfo& t : bInfo)
+		{
+			if (t.lhs.empty())
+			{
+				bLeaves.insert(make_pair(*t.label, trans_list_type())).first->second.push_back(&t);
+			} else
+			{
+				bTrans.insert(make_pair(*t.label, trans_list_type())).first->second.push_back(&t);
 			}
 		}
-		antichain.finalizeTransitions();
 		// initialization
 		// Post(\emptyset)
-		std::vector<std::pair<size_t, std::set<size_t> > > post;
+		std::vector<std::pair<size_t, state_set_type> > post;
 		for (typename trans_list_type::iterator i = aLeaves.begin(); i != aLeaves.end(); ++i)
 		{
-			typename std::unordered_map<T, trans_list_type>::iterator range = bLeaves.find((*i)->first.label());
+			typename std::unordered_map<T, trans_list_type>::iterator range = bLeaves.find(*(*i)->label);
 			// careful
 			if (range == bLeaves.end())
 				return false;
-			std::pair<size_t, std::set<size_t>> newEl((*i)->first.rhs(), std::set<size_t>());
-			bool isAccepting = c.isFinalState(newEl.first);
+			std::pair<size_t, state_set_type> newEl((*i)->rhs, state_set_type(countB));
 			for (typename trans_list_type::iterator j = range->second.begin(); j != range->second.end(); ++j)
-				antichain.simInsert(newEl, isAccepting, (*j)->first.rhs(), c);
-			if (isAccepting)
-				return false;
-			// cross-automata check
-			if (!utils::checkIntersection(newEl.second, upsimIndex[newEl.first]))
-				post.push_back(newEl);
+				newEl.second.set((*j)->rhs);
+			post.push_back(newEl);
 		}
 		antichain.initialize(post);
 		// main loop
 		std::pair<size_t, state_cache_type::value_type*> el;
-		//size_t iter = 0;
 		while (antichain.nextElement(el))
 		{
 			// Post(Processed)
@@ -267,30 +240,23 @@ public:
 				{
 					if (!response.get(el, *j, i))
 						continue;
-					typename std::unordered_map<T, trans_list_type>::iterator range = bTrans.find((*j)->first.label());
+					typename std::unordered_map<T, trans_list_type>::iterator range = bTrans.find(*(*j)->label);
 					// careful
 					if (range == bTrans.end())
 						return false;
 					do
 					{
-						std::pair<size_t, std::set<size_t>> newEl((*j)->first.rhs(), std::set<size_t>());
-						bool isAccepting = c.isFinalState(newEl.first);
+						std::pair<size_t, state_set_type> newEl((*j)->rhs, state_set_type(countB));
 						for (typename trans_list_type::iterator k = range->second.begin(); k != range->second.end(); ++k)
 						{
 							if (response.match(*k))
-								antichain.simInsert(newEl, isAccepting, (*k)->first.rhs(), c);
-						}
-						if (isAccepting)
-						{
-							return false;
+								newEl.second.set((*k)->rhs);
 						}
-						if (newEl.second.empty())
+						if (newEl.second.none())
 						{
 							return false;
 						}
-						// cross-automata check
-						if (!utils::checkIntersection(newEl.second, upsimIndex[newEl.first]))
-							post.push_back(newEl);
+						post.push_back(newEl);
 					} while (response.next());
 				}
 			}
@@ -298,6 +264,24 @@ public:
 		}
 		return true;
 	}
+
+private:
+
+	static void translate(
+		std::vector<TransInfo>&      dst,
+		const TA<T>&                 src,
+		const Index<size_t>&         index,
+		size_t                       offset)
+	{
+		for (const TT<T>& trans : src)
+		{
+			dst.push_back(TransInfo());
+			TransInfo& info = dst.back();
+			info.label = &trans.label();
+			index.translate(info.lhs, trans.lhs(), offset);
+			info.rhs = index[trans.rhs()] + offset;
+		}
+	}
 };
 
 #endif
@@ -0,0 +1,676 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of forester.
+ *
+ * forester is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * forester is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with forester.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Standard library headers
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+
+// Forester headers
+#include "autdump.hh"
+#include "restart_request.hh"
+
+namespace
+{	// anonymous namespace
+
+/// kinds of labels in a label definition
+enum class label_kind_e : unsigned char
+{
+	lData,
+	lVData,
+	lNode
+};
+
+/// kinds of boxes in a box definition
+enum class box_kind_e : unsigned char
+{
+	bSel,
+	bType,
+	bBox
+};
+
+void putSelData(std::ostream& os, const SelData& sel)
+{
+	AutDumpWriter::putNumber(os, sel.offset);
+	AutDumpWriter::putInt(os, sel.size);
+	AutDumpWriter::putInt(os, sel.displ);
+	AutDumpWriter::putString(os, sel.name);
+}
+
+void putSignature(
+	std::ostream&                                 os,
+	const ConnectionGraph::CutpointSignature&     signature)
+{
+	AutDumpWriter::putNumber(os, signature.size());
+	for (const ConnectionGraph::CutpointInfo& cutpoint : signature)
+	{
+		AutDumpWriter::putNumber(os, cutpoint.root);
+		AutDumpWriter::putNumber(os, cutpoint.refCount);
+		AutDumpWriter::putNumber(os, cutpoint.selCount);
+		os.put(cutpoint.refInherited);
+		AutDumpWriter::putSet(os, cutpoint.fwdSelectors);
+		AutDumpWriter::putNumber(os, cutpoint.bwdSelector);
+		AutDumpWriter::putSet(os, cutpoint.defines);
+	}
+}
+
+} // namespace
+
+
+// AutDumpWriter
+
+void AutDumpWriter::putNumber(std::ostream& os, size_t num)
+{
+	// variable-length quantity, 7 bits per byte, the least significant first
+	while (0x80 <= num)
+	{
+		os.put(static_cast<char>(0x80 | (num & 0x7F)));
+		num >>= 7;
+	}
+
+	os.put(static_cast<char>(num));
+}
+
+void AutDumpWriter::putInt(std::ostream& os, long long num)
+{
+	// zig-zag encoding keeps small negative numbers short
+	const size_t unum = static_cast<size_t>(num);
+	putNumber(os, (num < 0)? ~(unum << 1) : (unum << 1));
+}
+
+void AutDumpWriter::putString(std::ostream& os, const std::string& str)
+{
+	putNumber(os, str.size());
+	os.write(str.data(), str.size());
+}
+
+void AutDumpWriter::putSet(std::ostream& os, const std::set<size_t>& s)
+{
+	putNumber(os, s.size());
+	for (size_t x : s)
+		putNumber(os, x);
+}
+
+void AutDumpWriter::putData(std::ostream& os, const Data& data)
+{
+	os.put(static_cast<char>(data.type));
+	putInt(os, data.size);
+
+	switch (data.type)
+	{
+		case data_type_e::t_native_ptr:
+			// only compared by value, so the pointer itself does the job
+			putNumber(os, reinterpret_cast<size_t>(data.d_native_ptr));
+			break;
+
+		case data_type_e::t_void_ptr:
+			putNumber(os, data.d_void_ptr_size);
+			break;
+
+		case data_type_e::t_ref:
+			putNumber(os, data.d_ref.root);
+			putInt(os, data.d_ref.displ);
+			break;
+
+		case data_type_e::t_int:
+			putInt(os, data.d_int);
+			break;
+
+		case data_type_e::t_bool:
+			os.put(data.d_bool);
+			break;
+
+		case data_type_e::t_struct:
+			putNumber(os, data.d_struct->size());
+			for (const Data::item_info& item : *data.d_struct)
+			{
+				putNumber(os, item.first);
+				putData(os, item.second);
+			}
+			break;
+
+		default:
+			break;
+	}
+}
+
+void AutDumpWriter::defineBox(const AbstractBox* aBox)
+{
+	if (boxes_.count(aBox))
+		return;
+
+	std::ostringstream os;
+	switch (aBox->getType())
+	{
+		case box_type_e::bSel:
+			os.put(static_cast<char>(box_kind_e::bSel));
+			putSelData(os, static_cast<const SelBox*>(aBox)->getData());
+			break;
+
+		case box_type_e::bTypeInfo:
+		{
+			const TypeBox* typeBox = static_cast<const TypeBox*>(aBox);
+			os.put(static_cast<char>(box_kind_e::bType));
+			putString(os, typeBox->getName());
+			putNumber(os, typeBox->getSelectors().size());
+			for (size_t sel : typeBox->getSelectors())
+				putNumber(os, sel);
+			break;
+		}
+
+		case box_type_e::bBox:
+		{
+			const Box* box = static_cast<const Box*>(aBox);
+			const Box::Signature signature = box->getSignature();
+
+			// the nested automata are written in place, their labels are defined
+			// before this box
+			os.put(static_cast<char>(box_kind_e::bBox));
+			this->putTA(os, *box->getOutput());
+			putSignature(os, signature.outputSignature);
+			putNumber(os, box->getInputMap().size());
+			for (size_t sel : box->getInputMap())
+				putNumber(os, sel);
+			os.put(nullptr != box->getInput());
+			if (nullptr != box->getInput())
+				this->putTA(os, *box->getInput());
+			putNumber(os, signature.inputIndex);
+			putSignature(os, signature.inputSignature);
+			putNumber(os, signature.selectors.size());
+			for (const std::pair<size_t, size_t>& sel : signature.selectors)
+			{
+				putNumber(os, sel.first);
+				putNumber(os, sel.second);
+			}
+			break;
+		}
+
+		default:
+			assert(false);      // fail gracefully
+			break;
+	}
+
+	defs_.put('B');
+	defs_ << os.str();
+	boxes_.insert(std::make_pair(aBox, boxes_.size()));
+}
+
+void AutDumpWriter::defineLabel(const NodeLabel* label, size_t arity)
+{
+	if (labels_.count(label))
+		return;
+
+	std::ostringstream os;
+	switch (label->GetType())
+	{
+		case NodeLabel::node_type::n_data:
+			os.put(static_cast<char>(label_kind_e::lData));
+			putData(os, label->getData());
+			break;
+
+		case NodeLabel::node_type::n_vData:
+			// the label does not know its arity, it is taken from the transition
+			os.put(static_cast<char>(label_kind_e::lVData));
+			putNumber(os, arity);
+			putNumber(os, label->getVData().size());
+			for (const Data& data : label->getVData())
+				putData(os, data);
+			break;
+
+		case NodeLabel::node_type::n_node:
+			for (const AbstractBox* aBox : label->getNode())
+				this->defineBox(aBox);
+
+			os.put(static_cast<char>(label_kind_e::lNode));
+			putNumber(os, label->getNode().size());
+			for (const AbstractBox* aBox : label->getNode())
+				putNumber(os, boxes_.at(aBox));
+			os.put(nullptr != label->node.sels);
+			if (nullptr != label->node.sels)
+			{
+				putNumber(os, label->node.sels->size());
+				for (const SelData& sel : *label->node.sels)
+					putSelData(os, sel);
+			}
+			break;
+
+		default:
+			assert(false);      // fail gracefully
+			break;
+	}
+
+	defs_.put('L');
+	defs_ << os.str();
+	labels_.insert(std::make_pair(label, labels_.size()));
+}
+
+void AutDumpWriter::defineState(size_t state)
+{
+	if (!FA::isData(state) || dataStates_.count(_MSB_GET(state)))
+		return;
+
+	const NodeLabel* label = &*boxMan_.lookupLabel(
+		boxMan_.getData(_MSB_GET(state)));
+
+	this->defineLabel(label, 0);
+	dataStates_.insert(std::make_pair(_MSB_GET(state), labels_.at(label)));
+}
+
+void AutDumpWriter::defineTA(const TreeAut& ta)
+{
+	for (const TreeAut::Transition& trans : ta)
+	{
+		this->defineLabel(&*trans.label(), trans.lhs().size());
+		for (size_t state : trans.lhs())
+			this->defineState(state);
+		this->defineState(trans.rhs());
+	}
+
+	for (size_t state : ta.getFinalStates())
+		this->defineState(state);
+}
+
+void AutDumpWriter::putState(std::ostream& os, size_t state) const
+{
+	// the lowest bit tells data states from the others
+	if (FA::isData(state))
+		putNumber(os, (dataStates_.at(_MSB_GET(state)) << 1) | 1);
+	else
+		putNumber(os, state << 1);
+}
+
+void AutDumpWriter::putTA(std::ostream& os, const TreeAut& ta)
+{
+	this->defineTA(ta);
+
+	putNumber(os, ta.getFinalStates().size());
+	for (size_t state : ta.getFinalStates())
+		this->putState(os, state);
+
+	putNumber(os, ta.getTransitions().size());
+	for (const TreeAut::Transition& trans : ta)
+	{
+		putNumber(os, labels_.at(&*trans.label()));
+		putNumber(os, trans.lhs().size());
+		for (size_t state : trans.lhs())
+			this->putState(os, state);
+		this->putState(os, trans.rhs());
+	}
+}
+
+void AutDumpWriter::putFAE(std::ostream& os, const FAE& fae)
+{
+	putNumber(os, fae.nextState());
+
+	putNumber(os, fae.getRootCount());
+	for (const std::shared_ptr<TreeAut>& root : fae.getRoots())
+	{
+		os.put(nullptr != root);
+		if (nullptr != root)
+			this->putTA(os, *root);
+	}
+
+	putNumber(os, fae.GetVarCount());
+	for (const Data& var : fae.GetVariables())
+		putData(os, var);
+}
+
+void AutDumpWriter::defineBoxDatabase()
+{
+	std::vector<const Box*> boxes;
+	boxMan_.boxDatabase().asVector(boxes);
+	for (const Box* box : boxes)
+		this->defineBox(box);
+}
+
+
+// AutDumpReader
+
+size_t AutDumpReader::getNumber(std::istream& is)
+{
+	size_t num = 0;
+	for (unsigned shift = 0; ; shift += 7)
+	{
+		const int c = is.get();
+		if (!is.good())
+			throw std::runtime_error("AutDumpReader: unexpected end of the dump");
+
+		num |= static_cast<size_t>(c & 0x7F) << shift;
+		if (!(c & 0x80))
+			return num;
+	}
+}
+
+long long AutDumpReader::getInt()
+{
+	const size_t unum = this->getNumber();
+	return (unum & 1)
+		? static_cast<long long>(~(unum >> 1))
+		: static_cast<long long>(unum >> 1);
+}
+
+std::string AutDumpReader::getString()
+{
+	std::string str(this->getNumber(), '\0');
+	if (!is_.read(&str[0], str.size()))
+		throw std::runtime_error("AutDumpReader: unexpected end of the dump");
+
+	return str;
+}
+
+void AutDumpReader::getSet(std::set<size_t>& s)
+{
+	for (size_t cnt = this->getNumber(); cnt; --cnt)
+		s.insert(this->getNumber());
+}
+
+Data AutDumpReader::getData()
+{
+	const data_type_e type = static_cast<data_type_e>(is_.get());
+	const int size = this->getInt();
+
+	Data data;
+	switch (type)
+	{
+		case data_type_e::t_undef:
+		case data_type_e::t_unknw:
+		case data_type_e::t_other:
+			data = Data(type);
+			break;
+
+		case data_type_e::t_native_ptr:
+			data = Data::createNativePtr(reinterpret_cast<void*>(this->getNumber()));
+			break;
+
+		case data_type_e::t_void_ptr:
+			data = Data::createVoidPtr(this->getNumber());
+			break;
+
+		case data_type_e::t_ref:
+		{
+			const size_t root = this->getNumber();
+			data = Data::createRef(root, this->getInt());
+			break;
+		}
+
+		case data_type_e::t_int:
+			data = Data::createInt(this->getInt());
+			break;
+
+		case data_type_e::t_bool:
+			data = Data::createBool(is_.get());
+			break;
+
+		case data_type_e::t_struct:
+		{
+			std::vector<Data::item_info> items;
+			for (size_t cnt = this->getNumber(); cnt; --cnt)
+			{
+				const size_t offset = this->getNumber();
+				items.push_back(std::make_pair(offset, this->getData()));
+			}
+
+			data = Data::createStruct(items);
+			break;
+		}
+
+		default:
+			throw std::runtime_error("AutDumpReader: invalid data type");
+	}
+
+	data.size = size;
+	return data;
+}
+
+size_t AutDumpReader::getState()
+{
+	const size_t num = this->getNumber();
+	if (!(num & 1))
+		return num >> 1;
+
+	// data states are renumbered according to our box manager
+	if (labels_.size() <= (num >> 1))
+		throw std::runtime_error("AutDumpReader: undefined data state");
+
+	return _MSB_ADD(labels_[num >> 1]->getDataId());
+}
+
+label_type AutDumpReader::getLabel()
+{
+	const size_t id = this->getNumber();
+	if (labels_.size() <= id)
+		throw std::runtime_error("AutDumpReader: undefined label");
+
+	return labels_[id];
+}
+
+const AbstractBox* AutDumpReader::getBox()
+{
+	const size_t id = this->getNumber();
+	if (boxes_.size() <= id)
+		throw std::runtime_error("AutDumpReader: undefined box");
+
+	return boxes_[id];
+}
+
+void AutDumpReader::getSignature(ConnectionGraph::CutpointSignature& signature)
+{
+	for (size_t cnt = this->getNumber(); cnt; --cnt)
+	{
+		ConnectionGraph::CutpointInfo cutpoint(this->getNumber());
+		cutpoint.refCount = this->getNumber();
+		cutpoint.selCount = this->getNumber();
+		cutpoint.refInherited = is_.get();
+		cutpoint.fwdSelectors.clear();
+		this->getSet(cutpoint.fwdSelectors);
+		cutpoint.bwdSelector = this->getNumber();
+		this->getSet(cutpoint.defines);
+		signature.push_back(cutpoint);
+	}
+}
+
+void AutDumpReader::getTA(TreeAut& ta)
+{
+	for (size_t cnt = this->getNumber(); cnt; --cnt)
+		ta.addFinalState(this->getState());
+
+	std::vector<size_t> lhs;
+	for (size_t cnt = this->getNumber(); cnt; --cnt)
+	{
+		const label_type label = this->getLabel();
+
+		lhs.resize(this->getNumber());
+		for (size_t& state : lhs)
+			state = this->getState();
+
+		ta.addTransition(lhs, label, this->getState());
+	}
+}
+
+void AutDumpReader::getFAE(FAE& fae)
+{
+	fae.setStateOffset(this->getNumber());
+
+	for (size_t cnt = this->getNumber(); cnt; --cnt)
+	{
+		TreeAut* ta = nullptr;
+		if (is_.get())
+		{
+			ta = new TreeAut(backend_);
+			this->getTA(*ta);
+		}
+
+		fae.appendRoot(ta);
+		fae.connectionGraph.newRoot();
+	}
+
+	for (size_t cnt = this->getNumber(); cnt; --cnt)
+		fae.PushVar(this->getData());
+
+	fae.updateConnectionGraph();
+}
+
+void AutDumpReader::readLabel()
+{
+	switch (static_cast<label_kind_e>(is_.get()))
+	{
+		case label_kind_e::lData:
+			labels_.push_back(boxMan_.lookupLabel(this->getData()));
+			break;
+
+		case label_kind_e::lVData:
+		{
+			const size_t arity = this->getNumber();
+			DataArray vData(this->getNumber());
+			for (Data& data : vData)
+				data = this->getData();
+
+			labels_.push_back(boxMan_.lookupLabel(arity, vData));
+			break;
+		}
+
+		case label_kind_e::lNode:
+		{
+			std::vector<const AbstractBox*> node(this->getNumber());
+			for (const AbstractBox*& aBox : node)
+				aBox = this->getBox();
+
+			const std::vector<SelData>* nodeInfo = nullptr;
+			if (is_.get())
+			{
+				std::vector<SelData> sels;
+				for (size_t cnt = this->getNumber(); cnt; --cnt)
+				{
+					const size_t offset = this->getNumber();
+					const int size = this->getInt();
+					const int displ = this->getInt();
+					sels.push_back(SelData(offset, size, displ, this->getString()));
+				}
+
+				// the descriptor is bound to the type box of the node
+				const TypeBox* typeBox = nullptr;
+				for (const AbstractBox* aBox : node)
+				{
+					if (aBox->isType(box_type_e::bTypeInfo))
+						typeBox = static_cast<const TypeBox*>(aBox);
+				}
+
+				nodeInfo = boxMan_.LookupTypeDesc(typeBox, sels);
+			}
+
+			labels_.push_back(boxMan_.lookupLabel(node, nodeInfo));
+			break;
+		}
+
+		default:
+			throw std::runtime_error("AutDumpReader: invalid label definition");
+	}
+}
+
+void AutDumpReader::readBox()
+{
+	switch (static_cast<box_kind_e>(is_.get()))
+	{
+		case box_kind_e::bSel:
+		{
+			const size_t offset = this->getNumber();
+			const int size = this->getInt();
+			const int displ = this->getInt();
+			boxes_.push_back(boxMan_.getSelector(
+				SelData(offset, size, displ, this->getString())));
+			break;
+		}
+
+		case box_kind_e::bType:
+		{
+			const std::string name = this->getString();
+			std::vector<size_t> selectors(this->getNumber());
+			for (size_t& sel : selectors)
+				sel = this->getNumber();
+
+			boxes_.push_back(boxMan_.createTypeInfo(name, selectors));
+			break;
+		}
+
+		case box_kind_e::bBox:
+		{
+			std::shared_ptr<TreeAut> output(new TreeAut(backend_));
+			this->getTA(*output);
+
+			ConnectionGraph::CutpointSignature outputSignature;
+			this->getSignature(outputSignature);
+
+			std::vector<size_t> inputMap(this->getNumber());
+			for (size_t& sel : inputMap)
+				sel = this->getNumber();
+
+			std::shared_ptr<TreeAut> input;
+			if (is_.get())
+			{
+				input = std::shared_ptr<TreeAut>(new TreeAut(backend_));
+				this->getTA(*input);
+			}
+
+			const size_t inputIndex = this->getNumber();
+
+			ConnectionGraph::CutpointSignature inputSignature;
+			this->getSignature(inputSignature);
+
+			std::vector<std::pair<size_t, size_t>> selectors(this->getNumber());
+			for (std::pair<size_t, size_t>& sel : selectors)
+			{
+				sel.first = this->getNumber();
+				sel.second = this->getNumber();
+			}
+
+			const Box box("", output, outputSignature, inputMap, input,
+				inputIndex, inputSignature, selectors);
+
+			try
+			{
+				boxes_.push_back(boxMan_.getBox(box));
+			}
+			catch (const RestartRequest&)
+			{	// the box has been inserted into the database anyway
+				boxes_.push_back(boxMan_.lookupBox(box));
+			}
+			break;
+		}
+
+		default:
+			throw std::runtime_error("AutDumpReader: invalid box definition");
+	}
+}
+
+bool AutDumpReader::readDefinition(int tag)
+{
+	switch (tag)
+	{
+		case 'L':
+			this->readLabel();
+			return true;
+
+		case 'B':
+			this->readBox();
+			return true;
+
+		default:
+			return false;
+	}
+}
@@ -0,0 +1,219 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of forester.
+ *
+ * forester is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * forester is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with forester.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef AUT_DUMP_H
+#define AUT_DUMP_H
+
+/**
+ * @file autdump.hh
+ * Compact binary serialization of tree automata and forest automata
+ *
+ * The dump is a stream of records.  Labels and boxes are interned: each of them
+ * is defined once by a record of its own (tagged by @p 'L' or @p 'B') that
+ * precedes the first automaton referring to it, automata then refer to them by
+ * their IDs.  Data states (those with the MSB set) are stored as references to
+ * the labels of their data, so that they can be mapped to the data IDs of the
+ * box manager that reads the dump.  All integers are stored as (zig-zag
+ * encoded) variable-length quantities.
+ */
+
+// Standard library headers
+#include <istream>
+#include <ostream>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Forester headers
+#include "boxman.hh"
+#include "forestautext.hh"
+#include "treeaut_label.hh"
+#include "types.hh"
+
+/**
+ * @brief  Writes tree automata and forest automata into a binary dump
+ *
+ * Definitions of labels and boxes go directly to the stream given to the
+ * constructor, the automata themselves are written into the stream passed to
+ * each of the @p put* methods.  The caller is thus free to buffer a record and
+ * append it to the dump later on, after the definitions it depends on.
+ */
+class AutDumpWriter
+{
+private:  // data members
+
+	/// the stream where definitions of labels and boxes are written
+	std::ostream& defs_;
+
+	/// the box manager owning the labels, boxes, and data
+	BoxMan& boxMan_;
+
+	std::unordered_map<const NodeLabel*, size_t> labels_;
+	std::unordered_map<const AbstractBox*, size_t> boxes_;
+
+	/// maps data IDs of @p boxMan_ to IDs of labels in the dump
+	std::unordered_map<size_t, size_t> dataStates_;
+
+private:  // methods
+
+	AutDumpWriter(const AutDumpWriter&);
+	AutDumpWriter& operator=(const AutDumpWriter&);
+
+	void defineTA(const TreeAut& ta);
+	void defineState(size_t state);
+	void defineLabel(const NodeLabel* label, size_t arity);
+	void defineBox(const AbstractBox* aBox);
+
+	void putState(std::ostream& os, size_t state) const;
+
+public:   // methods
+
+	AutDumpWriter(std::ostream& defs, BoxMan& boxMan) :
+		defs_(defs),
+		boxMan_(boxMan),
+		labels_{},
+		boxes_{},
+		dataStates_{}
+	{ }
+
+	/**
+	 * @brief  Writes a tree automaton
+	 *
+	 * Writes the tree automaton @p ta into the stream @p os, labels and boxes
+	 * that are not defined yet are defined first.
+	 *
+	 * @param[out]  os  The stream where the automaton is written
+	 * @param[in]   ta  The tree automaton to be written
+	 */
+	void putTA(std::ostream& os, const TreeAut& ta);
+
+	/**
+	 * @brief  Writes a forest automaton
+	 *
+	 * Writes the roots, the global variables, and the state offset of @p fae
+	 * into the stream @p os.  The connection graph is not written, it is
+	 * computed again when the forest automaton is read.
+	 *
+	 * @param[out]  os   The stream where the automaton is written
+	 * @param[in]   fae  The forest automaton to be written
+	 */
+	void putFAE(std::ostream& os, const FAE& fae);
+
+	/**
+	 * @brief  Defines all boxes of the box database
+	 *
+	 * Defines the boxes in the database of the box manager that are not defined
+	 * yet, so that the reader has the same boxes available for folding.
+	 */
+	void defineBoxDatabase();
+
+	static void putNumber(std::ostream& os, size_t num);
+	static void putInt(std::ostream& os, long long num);
+	static void putString(std::ostream& os, const std::string& str);
+	static void putSet(std::ostream& os, const std::set<size_t>& s);
+	static void putData(std::ostream& os, const Data& data);
+};
+
+/**
+ * @brief  Reads tree automata and forest automata from a binary dump
+ *
+ * The reader translates the labels, boxes, and data of the dump into those of
+ * the given box manager, boxes are inserted into its database.
+ */
+class AutDumpReader
+{
+private:  // data members
+
+	std::istream& is_;
+
+	BoxMan& boxMan_;
+
+	TreeAut::Backend& backend_;
+
+	std::vector<label_type> labels_;
+	std::vector<const AbstractBox*> boxes_;
+
+private:  // methods
+
+	AutDumpReader(const AutDumpReader&);
+	AutDumpReader& operator=(const AutDumpReader&);
+
+	size_t getState();
+	label_type getLabel();
+	const AbstractBox* getBox();
+
+	void getSignature(ConnectionGraph::CutpointSignature& signature);
+
+	void readLabel();
+	void readBox();
+
+public:   // methods
+
+	AutDumpReader(
+		std::istream&          is,
+		BoxMan&                boxMan,
+		TreeAut::Backend&      backend) :
+		is_(is),
+		boxMan_(boxMan),
+		backend_(backend),
+		labels_{},
+		boxes_{}
+	{ }
+
+	/**
+	 * @brief  Reads a definition
+	 *
+	 * Reads the definition of a label or a box in the case @p tag is the tag of
+	 * a definition.
+	 *
+	 * @param[in]  tag  The tag of the record that has just been read
+	 *
+	 * @returns  @p true if the record was a definition, @p false otherwise
+	 */
+	bool readDefinition(int tag);
+
+	/**
+	 * @brief  Reads a tree automaton
+	 *
+	 * @param[out]  ta  The tree automaton (expected to be empty)
+	 */
+	void getTA(TreeAut& ta);
+
+	/**
+	 * @brief  Reads a forest automaton
+	 *
+	 * @param[out]  fae  The forest automaton (expected to be empty)
+	 */
+	void getFAE(FAE& fae);
+
+	size_t getNumber()
+	{
+		return AutDumpReader::getNumber(is_);
+	}
+
+	static size_t getNumber(std::istream& is);
+
+	long long getInt();
+	std::string getString();
+	void getSet(std::set<size_t>& s);
+	Data getData();
+};
+
+#endif
@@ -369,6 +369,11 @@ public:
 		return inputMap_[input];
 	}
 
+	const std::vector<size_t>& getInputMap() const
+	{
+		return inputMap_;
+	}
+
 	bool hasSelfReference() const
 	{
 		return selfReference_;
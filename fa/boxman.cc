@@ -173,7 +173,7 @@ const std::pair<const Data, NodeLabel*>& BoxMan::insertData(const Data& data)
 
 	if (p.second)
 	{
-		p.first->second = new NodeLabel(&p.first->first, dataIndex_.size());
+		p.first->second = this->newLabel(&p.first->first, dataIndex_.size());
 		dataIndex_.push_back(&p.first->first);
 	}
 	return *p.first;
@@ -200,7 +200,7 @@ label_type BoxMan::lookupLabel(
 	std::pair<TVarDataStore::iterator, bool> p = vDataStore_.insert(
 		std::make_pair(std::make_pair(arity, x), static_cast<NodeLabel*>(nullptr)));
 	if (p.second)
-		p.first->second = new NodeLabel(&p.first->first.second);
+		p.first->second = this->newLabel(&p.first->first.second);
 
 	return p.first->second;
 }
@@ -253,7 +253,7 @@ label_type BoxMan::lookupLabel(
 
 	if (p.second)
 	{
-		NodeLabel* label = new NodeLabel(&p.first->first, nodeInfo);
+		NodeLabel* label = this->newLabel(&p.first->first, nodeInfo);
 
 		std::vector<size_t> tag;
 
@@ -439,11 +439,13 @@ const Box* BoxMan::getBox(const Box& box)
 
 void BoxMan::clear()
 {
-	utils::eraseMap(dataStore_);
+	// the labels are owned by the table
+	dataStore_.clear();
 	dataIndex_.clear();
-	utils::eraseMap(nodeStore_);
+	nodeStore_.clear();
 	tagStore_.clear();
-	utils::eraseMap(vDataStore_);
+	vDataStore_.clear();
+	labels_.clear();
 	utils::eraseMap(selIndex_);
 	utils::eraseMap(typeIndex_);
 	boxes_.clear();
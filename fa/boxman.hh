@@ -21,6 +21,7 @@
 #define BOX_MANAGER_H
 
 // Standard library headers
+#include <deque>
 #include <vector>
 #include <string>
 #include <unordered_map>
@@ -278,6 +279,9 @@ private:  // data types
 
 private:  // data members
 
+	/// the table of all labels, the label with ID @p i is at position @p i-1
+	std::deque<NodeLabel> labels_;
+
 	TDataStore dataStore_;
 	std::vector<const Data*> dataIndex_;
 	TNodeStore nodeStore_;
@@ -293,6 +297,20 @@ private:  // data members
 
 private:  // methods
 
+	/**
+	 * @brief  Appends a new label to the table of labels
+	 *
+	 * @param[in]  args  Arguments of the constructor of the label (except the ID)
+	 *
+	 * @returns  The new label
+	 */
+	template <class... Args>
+	NodeLabel* newLabel(Args&&... args)
+	{
+		labels_.emplace_back(labels_.size() + 1, std::forward<Args>(args)...);
+		return &labels_.back();
+	}
+
 	const std::pair<const Data, NodeLabel*>& insertData(const Data& data);
 
 
@@ -454,6 +472,7 @@ public:
 	}
 
 	BoxMan() :
+		labels_{},
 		dataStore_{},
 		dataIndex_{},
 		nodeStore_{},
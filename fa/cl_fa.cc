@@ -27,6 +27,7 @@
 #include "../cl/ssd.h"
 
 // Forester headers
+#include "kernellog.hh"
 #include "notimpl_except.hh"
 #include "programconfig.hh"
 #include "streams.hh"
@@ -123,6 +124,12 @@ void clEasyRun(const CodeStorage::Storage& stor, const char* configString)
 	{
 		se = new SymExec(conf);
 
+		if (!conf.kernelLog.empty())
+		{
+			FA_LOG("logging kernel inputs into " << conf.kernelLog << " ...");
+			KernelLog::open(conf.kernelLog);
+		}
+
 		FA_LOG("loading types ...");
 		se->loadTypes(stor);
 
@@ -168,6 +175,8 @@ void clEasyRun(const CodeStorage::Storage& stor, const char* configString)
 		FA_ERROR(e.what());
 	}
 
+	KernelLog::close();
+
 	delete se;
 
 	FA_LOG("Forester finished.");
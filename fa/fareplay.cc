@@ -0,0 +1,255 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of forester.
+ *
+ * forester is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * forester is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with forester.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file fareplay.cc
+ * main() of the standalone driver, which replays the calls of the automata
+ * kernels recorded by the @b "kernel-log:<file>" option of the analysis and
+ * measures the time taken by each of the kernels, without any need to run gcc
+ */
+
+// Standard library headers
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <stdexcept>
+
+// Code Listener headers
+#include <cl/code_listener.h>
+
+// Forester headers
+#include "abstraction.hh"
+#include "autdump.hh"
+#include "boxman.hh"
+#include "folding.hh"
+#include "forestautext.hh"
+#include "kernellog.hh"
+#include "restart_request.hh"
+
+namespace
+{	// anonymous namespace
+
+typedef KernelLog::kernel_e kernel_e;
+
+const char* const kernelNames[] =
+{
+	"subseteq",
+	"minimized",
+	"heightAbs",
+	"discover1",
+	"discover2",
+	"discover3"
+};
+
+const size_t kernelCount = sizeof kernelNames / sizeof *kernelNames;
+
+/**
+ * @brief  Statistics of the replayed calls of a single kernel
+ */
+struct KernelStats
+{
+	size_t calls;
+	size_t mismatches;
+	clock_t time;
+
+	KernelStats() :
+		calls(0),
+		mismatches(0),
+		time(0)
+	{ }
+};
+
+/**
+ * @brief  Replays a single call of a kernel
+ *
+ * Reads the inputs of the call of @p kernel, calls the kernel, and returns the
+ * summary of its result in the form used by KernelLog::Entry::setResult() (or
+ * zero if the kernel did not return).  Only the call itself is measured.
+ */
+size_t replayKernel(
+	AutDumpReader&             reader,
+	BoxMan&                    boxMan,
+	TreeAut::Backend&          backend,
+	kernel_e                   kernel,
+	clock_t&                   time)
+{
+	switch (kernel)
+	{
+		case kernel_e::kSubseteq:
+		{
+			TreeAut a(backend), b(backend);
+			reader.getTA(a);
+			reader.getTA(b);
+
+			const clock_t start = clock();
+			const bool result = TreeAut::subseteq(a, b);
+			time += clock() - start;
+			return 1 + result;
+		}
+
+		case kernel_e::kMinimized:
+		{
+			TreeAut src(backend), dst(backend);
+			reader.getTA(src);
+
+			const clock_t start = clock();
+			src.minimized(dst);
+			time += clock() - start;
+			return 1 + dst.getTransitions().size();
+		}
+
+		case kernel_e::kHeightAbs:
+		{
+			FAE fae(backend, boxMan);
+			reader.getFAE(fae);
+			const size_t root = reader.getNumber();
+			const size_t height = reader.getNumber();
+
+			const clock_t start = clock();
+			Abstraction(fae).heightAbstraction(root, height, SmartTMatchF());
+			time += clock() - start;
+			return 1 + fae.getRoot(root)->getTransitions().size();
+		}
+
+		case kernel_e::kDiscover1:
+		case kernel_e::kDiscover2:
+		case kernel_e::kDiscover3:
+		{
+			FAE fae(backend, boxMan);
+			reader.getFAE(fae);
+			const size_t root = reader.getNumber();
+			std::set<size_t> forbidden;
+			reader.getSet(forbidden);
+			const bool conditional = reader.getNumber();
+
+			const clock_t start = clock();
+			try
+			{
+				Folding folding(fae, boxMan);
+				bool result;
+				if (kernel_e::kDiscover1 == kernel)
+					result = folding.discover1(root, forbidden, conditional);
+				else if (kernel_e::kDiscover2 == kernel)
+					result = folding.discover2(root, forbidden, conditional);
+				else
+					result = folding.discover3(root, forbidden, conditional);
+
+				time += clock() - start;
+				return 1 + result;
+			}
+			catch (const RestartRequest&)
+			{	// a new box has been learnt
+				time += clock() - start;
+				return 0;
+			}
+		}
+
+		default:
+			throw std::runtime_error("unknown kernel");
+	}
+}
+
+bool replayFile(const char* fileName)
+{
+	std::ifstream is(fileName, std::ios::in | std::ios::binary);
+	if (!is)
+	{
+		fprintf(stderr, "%s: unable to open\n", fileName);
+		return false;
+	}
+
+	if (!KernelLog::readHeader(is))
+	{
+		fprintf(stderr, "%s: not a kernel log of a known version\n", fileName);
+		return false;
+	}
+
+	TreeAut::Backend backend;
+	BoxMan boxMan;
+	AutDumpReader reader(is, boxMan, backend);
+	KernelStats stats[kernelCount];
+
+	try
+	{
+		for (int tag; EOF != (tag = is.get()); )
+		{
+			if (reader.readDefinition(tag))
+				continue;
+
+			if ('K' != tag)
+				throw std::runtime_error("invalid record");
+
+			const size_t kernel = is.get();
+			if (kernelCount <= kernel)
+				throw std::runtime_error("unknown kernel");
+
+			KernelStats& kernelStats = stats[kernel];
+			const size_t result = replayKernel(reader, boxMan, backend,
+				static_cast<kernel_e>(kernel), kernelStats.time);
+
+			++kernelStats.calls;
+			if (reader.getNumber() != result)
+				++kernelStats.mismatches;
+		}
+	}
+	catch (const std::exception& e)
+	{
+		fprintf(stderr, "%s: %s\n", fileName, e.what());
+		return false;
+	}
+
+	printf("%s:\n", fileName);
+	printf("  %-12s %8s %10s %10s\n", "kernel", "calls", "time [s]", "mismatches");
+	for (size_t i = 0; i < kernelCount; ++i)
+	{
+		printf("  %-12s %8lu %10.3f %10lu\n", kernelNames[i],
+			static_cast<unsigned long>(stats[i].calls),
+			static_cast<double>(stats[i].time) / CLOCKS_PER_SEC,
+			static_cast<unsigned long>(stats[i].mismatches));
+	}
+
+	return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2)
+	{
+		fprintf(stderr, "Usage: %s LOG...\n"
+			"\n"
+			"Replay the calls of the automata kernels recorded in each LOG by the "
+			"\"kernel-log:LOG\"\noption of the analysis and print the time taken "
+			"by each of the kernels.  The\nresults differing from the recorded "
+			"ones are counted as mismatches.\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	cl_global_init_defaults(argv[0], 0);
+
+	bool ok = true;
+	for (int i = 1; i < argc; ++i)
+		ok &= replayFile(argv[i]);
+
+	cl_global_cleanup();
+
+	return (ok)? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -30,6 +30,7 @@
 #include "fixpoint.hh"
 #include "folding.hh"
 #include "forestautext.hh"
+#include "kernellog.hh"
 #include "normalization.hh"
 #include "regdef.hh"
 #include "splitting.hh"
@@ -51,21 +52,6 @@ struct ExactTMatchF
 	}
 };
 
-struct SmartTMatchF
-{
-	bool operator()(
-		const TT<label_type>&              t1,
-		const TT<label_type>&              t2)
-	{
-		if (t1.label()->isNode() && t2.label()->isNode())
-		{
-			return t1.label()->getTag() == t2.label()->getTag();
-		}
-
-		return t1.label() == t2.label();
-	}
-};
-
 class SmarterTMatchF
 {
 private:  // data members
@@ -193,6 +179,60 @@ bool normalize(
 }
 
 
+/**
+ * @brief  Discovers and folds a cutpoint, logging the call
+ *
+ * This function calls Folding::discover1(), Folding::discover2(), or
+ * Folding::discover3() according to @p kernel and logs the call in the case
+ * the kernel log is open.
+ *
+ * @param[in]  folding      The folding of @p fae
+ * @param[in]  kernel       The method of @p folding to be called
+ * @param[in]  fae          The forest automaton being folded
+ * @param[in]  boxMan       The database of boxes
+ * @param[in]  root         The cutpoint to be folded
+ * @param[in]  forbidden    The set of cutpoints not allowed for folding
+ * @param[in]  conditional  If @p true, no new boxes are learnt
+ *
+ * @returns  The result of the called method
+ */
+bool discover(
+	Folding&                     folding,
+	KernelLog::kernel_e          kernel,
+	const FAE&                   fae,
+	BoxMan&                      boxMan,
+	size_t                       root,
+	const std::set<size_t>&      forbidden,
+	bool                         conditional)
+{
+	KernelLog::Entry entry(boxMan, kernel);
+	entry.putBoxDatabase();
+	entry.putFAE(fae);
+	entry.putNumber(root);
+	entry.putSet(forbidden);
+	entry.putNumber(conditional);
+
+	bool result;
+	switch (kernel)
+	{
+		case KernelLog::kernel_e::kDiscover1:
+			result = folding.discover1(root, forbidden, conditional);
+			break;
+
+		case KernelLog::kernel_e::kDiscover2:
+			result = folding.discover2(root, forbidden, conditional);
+			break;
+
+		default:
+			assert(KernelLog::kernel_e::kDiscover3 == kernel);
+			result = folding.discover3(root, forbidden, conditional);
+			break;
+	}
+
+	entry.setResult(result);
+	return result;
+}
+
 /**
  * @brief  Folds a FA without learning
  *
@@ -231,17 +271,20 @@ bool fold(
 		// _ONLY_ using boxes which are _ALREADY_ in 'boxMan'. No learning of new
 		// boxes is allowed
 
-		if (folding.discover1(i, forbidden, true))
+		if (discover(folding, KernelLog::kernel_e::kDiscover1, fae, boxMan, i,
+			forbidden, true))
 		{
 			matched = true;
 		}
 
-		if (folding.discover2(i, forbidden, true))
+		if (discover(folding, KernelLog::kernel_e::kDiscover2, fae, boxMan, i,
+			forbidden, true))
 		{
 			matched = true;
 		}
 
-		if (folding.discover3(i, forbidden, true))
+		if (discover(folding, KernelLog::kernel_e::kDiscover3, fae, boxMan, i,
+			forbidden, true))
 		{
 			matched = true;
 		}
@@ -289,7 +332,8 @@ void reorder(
 bool testInclusion(
 	FAE&                           fae,
 	TreeAut&                       fwdConf,
-	UFAE&                          fwdConfWrapper)
+	UFAE&                          fwdConfWrapper,
+	BoxMan&                        boxMan)
 {
 	TreeAut ta(*fwdConf.backend);
 
@@ -299,16 +343,30 @@ bool testInclusion(
 
 	fwdConfWrapper.fae2ta(ta, index, fae);
 
-	if (TreeAut::subseteq(ta, fwdConf))
-		return true;
+	{
+		KernelLog::Entry entry(boxMan, KernelLog::kernel_e::kSubseteq);
+		entry.putTA(ta);
+		entry.putTA(fwdConf);
+
+		const bool included = TreeAut::subseteq(ta, fwdConf);
+		entry.setResult(included);
+
+		if (included)
+			return true;
+	}
 
 	fwdConfWrapper.join(ta, index);
 
 	ta.clear();
 
+	KernelLog::Entry entry(boxMan, KernelLog::kernel_e::kMinimized);
+	entry.putTA(fwdConf);
+
 	fwdConf.minimized(ta);
 	fwdConf = ta;
 
+	entry.setResult(fwdConf.getTransitions().size());
+
 	return false;
 }
 
@@ -364,8 +422,10 @@ void learn1(FAE& fae, BoxMan& boxMan)
 
 		assert(fae.getRoot(i));
 
-		folding.discover1(i, forbidden, false);
-		folding.discover2(i, forbidden, false);
+		discover(folding, KernelLog::kernel_e::kDiscover1, fae, boxMan, i, forbidden,
+			false);
+		discover(folding, KernelLog::kernel_e::kDiscover2, fae, boxMan, i, forbidden,
+			false);
 	}
 }
 
@@ -386,7 +446,8 @@ void learn2(
 
 		assert(fae.getRoot(i));
 
-		folding.discover3(i, forbidden, false);
+		discover(folding, KernelLog::kernel_e::kDiscover3, fae, boxMan, i, forbidden,
+			false);
 	}
 }
 } // namespace
@@ -463,8 +524,15 @@ void FI_abs::abstract(
 		{
 			if (!excludedRoots[i])
 			{
+				KernelLog::Entry entry(boxMan_, KernelLog::kernel_e::kHeightAbs);
+				entry.putFAE(fae);
+				entry.putNumber(i);
+				entry.putNumber(FA_ABS_HEIGHT);
+
 				abstraction.heightAbstraction(i, FA_ABS_HEIGHT, SmartTMatchF());
 //				abstraction.heightAbstraction(i, FA_ABS_HEIGHT, SmarterTMatchF(fae));
+
+				entry.setResult(fae.getRoot(i)->getTransitions().size());
 			}
 		}
 	}
@@ -532,7 +600,7 @@ void FI_abs::execute(ExecutionManager& execMan, SymState& state)
 	}
 #endif
 	// test inclusion
-	if (testInclusion(*fae, fwdConf_, fwdConfWrapper_))
+	if (testInclusion(*fae, fwdConf_, fwdConfWrapper_, boxMan_))
 	{
 		FA_DEBUG_AT(3, "hit");
 
@@ -598,7 +666,7 @@ void FI_fix::execute(ExecutionManager& execMan, SymState& state)
 	}
 #endif
 	// test inclusion
-	if (testInclusion(*fae, fwdConf_, fwdConfWrapper_))
+	if (testInclusion(*fae, fwdConf_, fwdConfWrapper_, boxMan_))
 	{
 		FA_DEBUG_AT(3, "hit");
 
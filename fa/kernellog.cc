@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of forester.
+ *
+ * forester is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * forester is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with forester.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Standard library headers
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+// Forester headers
+#include "autdump.hh"
+#include "kernellog.hh"
+
+namespace
+{	// anonymous namespace
+
+/// bump this whenever the layout of any record changes
+const size_t KERNEL_LOG_VERSION = 1;
+
+/// the log starts with this string (including the trailing zero)
+const char KERNEL_LOG_MAGIC[] = "forester-kernellog";
+
+std::ofstream* logFile = nullptr;
+
+/// created by the first entry, which tells the box manager in use
+AutDumpWriter* logWriter = nullptr;
+
+} // namespace
+
+
+void KernelLog::open(const std::string& fileName)
+{
+	KernelLog::close();
+
+	logFile = new std::ofstream(fileName.c_str(),
+		std::ios::out | std::ios::trunc | std::ios::binary);
+	if (!*logFile)
+	{
+		KernelLog::close();
+		throw std::runtime_error("unable to open " + fileName);
+	}
+
+	logFile->write(KERNEL_LOG_MAGIC, sizeof KERNEL_LOG_MAGIC);
+	AutDumpWriter::putNumber(*logFile, KERNEL_LOG_VERSION);
+}
+
+void KernelLog::close()
+{
+	delete logWriter;
+	logWriter = nullptr;
+
+	delete logFile;
+	logFile = nullptr;
+}
+
+bool KernelLog::isOpen()
+{
+	return nullptr != logFile;
+}
+
+bool KernelLog::readHeader(std::istream& is)
+{
+	char magic[sizeof KERNEL_LOG_MAGIC];
+	if (!is.read(magic, sizeof magic) || memcmp(magic, KERNEL_LOG_MAGIC, sizeof magic))
+		return false;
+
+	return AutDumpReader::getNumber(is) == KERNEL_LOG_VERSION;
+}
+
+
+// KernelLog::Entry
+
+KernelLog::Entry::Entry(BoxMan& boxMan, kernel_e kernel) :
+	kernel_(kernel),
+	body_(nullptr),
+	result_(0)
+{
+	if (nullptr == logFile)
+		return;
+
+	if (nullptr == logWriter)
+		logWriter = new AutDumpWriter(*logFile, boxMan);
+
+	body_ = new std::ostringstream;
+}
+
+KernelLog::Entry::~Entry()
+{
+	if (nullptr == body_)
+		return;
+
+	if (nullptr != logFile)
+	{	// the log might have been closed by the kernel (on error)
+		logFile->put('K');
+		logFile->put(static_cast<char>(kernel_));
+		*logFile << body_->str();
+		AutDumpWriter::putNumber(*logFile, result_);
+	}
+
+	delete body_;
+}
+
+void KernelLog::Entry::putTA(const TreeAut& ta)
+{
+	if (nullptr != body_)
+		logWriter->putTA(*body_, ta);
+}
+
+void KernelLog::Entry::putFAE(const FAE& fae)
+{
+	if (nullptr != body_)
+		logWriter->putFAE(*body_, fae);
+}
+
+void KernelLog::Entry::putNumber(size_t num)
+{
+	if (nullptr != body_)
+		AutDumpWriter::putNumber(*body_, num);
+}
+
+void KernelLog::Entry::putSet(const std::set<size_t>& s)
+{
+	if (nullptr != body_)
+		AutDumpWriter::putSet(*body_, s);
+}
+
+void KernelLog::Entry::putBoxDatabase()
+{
+	if (nullptr != body_)
+		logWriter->defineBoxDatabase();
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of forester.
+ *
+ * forester is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * forester is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with forester.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef KERNEL_LOG_H
+#define KERNEL_LOG_H
+
+/**
+ * @file kernellog.hh
+ * Opt-in log of the inputs of the automata kernels, replayed by @b fareplay
+ *
+ * The log starts with a magic string and a version, followed by a stream of
+ * records of the binary dump of automata (see autdump.hh).  Besides the
+ * definitions of labels and boxes, there is a @p 'K' record for each call of
+ * a logged kernel: the kind of the kernel, its inputs, and the summary of its
+ * result (or zero if the kernel did not return).
+ */
+
+// Standard library headers
+#include <istream>
+#include <set>
+#include <sstream>
+#include <string>
+
+// Forester headers
+#include "boxman.hh"
+#include "forestautext.hh"
+#include "treeaut_label.hh"
+
+class KernelLog
+{
+public:   // data types
+
+	/**
+	 * @brief  The logged kernels
+	 */
+	enum class kernel_e : unsigned char
+	{
+		kSubseteq,          ///< TreeAut::subseteq(a, b)
+		kMinimized,         ///< TreeAut::minimized(dst)
+		kHeightAbs,         ///< Abstraction::heightAbstraction(root, height)
+		kDiscover1,         ///< Folding::discover1(root, forbidden, conditional)
+		kDiscover2,         ///< Folding::discover2(root, forbidden, conditional)
+		kDiscover3          ///< Folding::discover3(root, forbidden, conditional)
+	};
+
+	/**
+	 * @brief  A single call of a kernel
+	 *
+	 * The inputs are serialized as they are passed in (the kernels often modify
+	 * them), the record is written once the entry is destroyed.  All methods do
+	 * nothing while the log is not open, so that the entry costs nothing then.
+	 */
+	class Entry
+	{
+	private:  // data members
+
+		kernel_e kernel_;
+
+		/// the record being built, @p nullptr if the log is not open
+		std::ostringstream* body_;
+
+		size_t result_;
+
+	private:  // methods
+
+		Entry(const Entry&);
+		Entry& operator=(const Entry&);
+
+	public:   // methods
+
+		Entry(BoxMan& boxMan, kernel_e kernel);
+
+		~Entry();
+
+		void putTA(const TreeAut& ta);
+
+		void putFAE(const FAE& fae);
+
+		void putNumber(size_t num);
+
+		void putSet(const std::set<size_t>& s);
+
+		/**
+		 * @brief  Defines the boxes the kernel may fold with
+		 */
+		void putBoxDatabase();
+
+		/**
+		 * @brief  Sets the summary of the result
+		 *
+		 * The summary is compared by the replay, it is a Boolean or the number of
+		 * transitions of the resulting automaton.
+		 */
+		void setResult(size_t result)
+		{
+			// zero is reserved for kernels that did not return
+			result_ = result + 1;
+		}
+	};
+
+public:   // methods
+
+	/**
+	 * @brief  Opens the log
+	 *
+	 * @param[in]  fileName  The name of the file to be (over)written
+	 */
+	static void open(const std::string& fileName);
+
+	/**
+	 * @brief  Closes the log (if open)
+	 */
+	static void close();
+
+	static bool isOpen();
+
+	/**
+	 * @brief  Reads and checks the header of a log
+	 *
+	 * @param[in,out]  is  The stream the log is read from
+	 *
+	 * @returns  @p true if the stream starts with a log of a known version
+	 */
+	static bool readHeader(std::istream& is);
+};
+
+#endif
@@ -21,6 +21,8 @@
 #define LABEL_H
 
 // Standard library headers
+#include <algorithm>
+#include <utility>
 #include <vector>
 #include <stdexcept>
 #include <unordered_map>
@@ -31,6 +33,10 @@
 
 /**
  * @brief  A memory node
+ *
+ * Labels are interned by BoxMan, which stores all of them in a single table
+ * and numbers them in the order of their creation.  Two labels are therefore
+ * equal iff their IDs are, and the ID is also used for ordering and hashing.
  */
 struct NodeLabel
 {
@@ -58,10 +64,35 @@ public:   // data types
 		{ }
 	};
 
+private:  // data types
+
+	/// the dense index may take at most this many slots per item of the node,
+	/// so that a selector at a large offset (e.g. a pointer after a large
+	/// embedded array) does not cost a slot for each byte before it
+	static const size_t maxDenseSlotsPerItem = 16;
+
 private:  // data members
 
 	node_type type_;
 
+	/// the ID of the label in the table of BoxMan (zero is reserved for no
+	/// label, which thus precedes all labels)
+	size_t id_;
+
+	/// items of a node in the order they were added
+	std::vector<NodeItem> items_;
+
+	/// maps offsets of selectors to positions in @p items_ (plus one, zero
+	/// marks an offset with no item), used as long as the offsets are dense
+	std::vector<unsigned> itemIndex_;
+
+	/// pairs (offset of a selector, position in @p items_ plus one) sorted by
+	/// the offset, used instead of @p itemIndex_ once the offsets are sparse
+	std::vector<std::pair<size_t, unsigned>> sparseIndex_;
+
+	/// position of the item of the type box in @p items_ (plus one)
+	unsigned typeItem_;
+
 public:   // data members
 
 	union
@@ -75,7 +106,6 @@ public:   // data members
 		struct
 		{
 			const std::vector<const AbstractBox*>* v;
-			std::unordered_map<size_t, NodeItem>* m;
 			const std::vector<SelData>* sels;
 			void* tag;
 		} node;
@@ -83,48 +113,130 @@ public:   // data members
 		const DataArray* vData;
 	};
 
-public:   // methods
+private:  // methods
 
-	NodeLabel() :
-		type_(node_type::n_unknown)
-	{ }
+	unsigned findSparse(size_t offset) const
+	{
+		auto it = std::lower_bound(sparseIndex_.cbegin(), sparseIndex_.cend(),
+			std::make_pair(offset, 0U));
+
+		return (sparseIndex_.cend() != it && it->first == offset)? it->second : 0;
+	}
+
+	const NodeItem* findItem(size_t offset) const
+	{
+		assert(node_type::n_node == type_);
+
+		size_t pos;
+		if (static_cast<size_t>(-1) == offset)
+			pos = typeItem_;
+		else if (!sparseIndex_.empty())
+			pos = this->findSparse(offset);
+		else if (offset < itemIndex_.size())
+			pos = itemIndex_[offset];
+		else
+			return nullptr;
+
+		return (pos)? &items_[pos - 1] : nullptr;
+	}
+
+public:   // methods
 
 	NodeLabel(
+		size_t                                      labelId,
 		const Data*                                 data,
 		size_t                                      id) :
-		type_(node_type::n_data)
+		type_(node_type::n_data),
+		id_(labelId),
+		items_{},
+		itemIndex_{},
+		sparseIndex_{},
+		typeItem_(0)
 	{
 		this->data.data = data;
 		this->data.id = id;
 	}
 
 	NodeLabel(
+		size_t                                      labelId,
 		const std::vector<const AbstractBox*>*      v,
 		const std::vector<SelData>*                 sels) :
-		type_(node_type::n_node)
+		type_(node_type::n_node),
+		id_(labelId),
+		items_{},
+		itemIndex_{},
+		sparseIndex_{},
+		typeItem_(0)
 	{
 		this->node.v = v;
-		this->node.m = new std::unordered_map<size_t, NodeItem>();
 		this->node.sels = sels;
+		this->node.tag = nullptr;
 	}
 
 	NodeLabel(
+		size_t                                      labelId,
 		const DataArray*                            vData) :
 		type_(node_type::n_vData),
+		id_(labelId),
+		items_{},
+		itemIndex_{},
+		sparseIndex_{},
+		typeItem_(0),
 		vData(vData)
 	{ }
 
-	~NodeLabel()
+	/**
+	 * @brief  Adds an item of a node
+	 *
+	 * @param[in]  key     The offset of the selector covered by the item, or
+	 *                     -1 for the type box
+	 * @param[in]  aBox    The box of the item
+	 * @param[in]  index   The position of @p aBox in the node
+	 * @param[in]  offset  The position of the first child of @p aBox
+	 */
+	void addMapItem(size_t key, const AbstractBox* aBox, size_t index, size_t offset)
 	{
-		if (node_type::n_node == type_)
-			delete this->node.m;
+		assert(nullptr == this->findItem(key));
+
+		items_.push_back(NodeItem(aBox, index, offset));
+
+		if (static_cast<size_t>(-1) == key)
+		{
+			typeItem_ = items_.size();
+			return;
+		}
+
+		const unsigned pos = items_.size();
+		if (sparseIndex_.empty() && key < maxDenseSlotsPerItem * pos)
+		{
+			if (itemIndex_.size() <= key)
+				itemIndex_.resize(key + 1, 0);
+
+			itemIndex_[key] = pos;
+			return;
+		}
+
+		if (sparseIndex_.empty())
+		{
+			// the offsets are too sparse, move the dense index to a sorted one
+			for (size_t off = 0; off < itemIndex_.size(); ++off)
+			{
+				if (itemIndex_[off])
+					sparseIndex_.push_back(std::make_pair(off, itemIndex_[off]));
+			}
+
+			std::vector<unsigned>().swap(itemIndex_);
+		}
+
+		auto it = std::lower_bound(sparseIndex_.begin(), sparseIndex_.end(),
+			std::make_pair(key, 0U));
+
+		sparseIndex_.insert(it, std::make_pair(key, pos));
 	}
 
-	void addMapItem(size_t key, const AbstractBox* aBox, size_t index, size_t offset)
+	size_t getId() const
 	{
-		assert(this->node.m->find(key) == this->node.m->end());
-
-		this->node.m->insert(std::make_pair(key, NodeItem(aBox, index, offset)));
+		return id_;
 	}
 
 	bool isData() const
@@ -154,19 +266,15 @@ public:   // methods
 
 	const AbstractBox* boxLookup(size_t offset, const AbstractBox* def) const
 	{
-		assert(node_type::n_node == type_);
-		auto i = this->node.m->find(offset);
-		if (i == this->node.m->end())
-			return def;
-		return i->second.aBox;
+		const NodeItem* item = this->findItem(offset);
+		return (nullptr != item)? item->aBox : def;
 	}
 
 	const NodeItem& boxLookup(size_t offset) const
 	{
-		assert(node_type::n_node == type_);
-		auto i = this->node.m->find(offset);
-		assert(i != this->node.m->end());
-		return i->second;
+		const NodeItem* item = this->findItem(offset);
+		assert(nullptr != item);
+		return *item;
 	}
 
 	node_type GetType() const
@@ -223,35 +331,51 @@ public:   // methods
 
 	bool operator<(const NodeLabel& rhs) const
 	{
-		return this->data.data < rhs.data.data;
+		return id_ < rhs.id_;
 	}
 
 	bool operator==(const NodeLabel& rhs) const
 	{
-		return this->data.data == rhs.data.data;
+		return id_ == rhs.id_;
 	}
 
 	bool operator!=(const NodeLabel& rhs) const
 	{
-		return this->data.data != rhs.data.data;
+		return id_ != rhs.id_;
 	}
 
 	friend std::ostream& operator<<(std::ostream& os, const NodeLabel& label);
 
 	friend size_t hash_value(const NodeLabel& label)
 	{
-		return boost::hash_value(label.data.data);
+		return label.id_;
 	}
 };
 
 
+/**
+ * @brief  A reference to an interned label
+ *
+ * The ID of the label is kept next to the pointer, so that transitions can be
+ * compared and hashed without touching the labels themselves.
+ */
 struct label_type
 {
 	const NodeLabel* _obj;
+	size_t _id;
 
-	label_type() : _obj(nullptr) {}
-	label_type(const label_type& label) : _obj(label._obj) {}
-	label_type(const NodeLabel* obj) : _obj(obj) {}
+	label_type() : _obj(nullptr), _id(0) {}
+	label_type(const label_type& label) : _obj(label._obj), _id(label._id) {}
+	label_type(const NodeLabel* obj) :
+		_obj(obj),
+		_id((nullptr != obj)? obj->getId() : 0)
+	{ }
+
+	label_type& operator=(const label_type& rhs) {
+		this->_obj = rhs._obj;
+		this->_id = rhs._id;
+		return *this;
+	}
 
 	const NodeLabel& operator*() const {
 		assert(this->_obj);
@@ -264,19 +388,19 @@ struct label_type
 	}
 
 	bool operator<(const label_type& rhs) const {
-		return this->_obj < rhs._obj;
+		return this->_id < rhs._id;
 	}
 
 	bool operator==(const label_type& rhs) const {
-		return this->_obj == rhs._obj;
+		return this->_id == rhs._id;
 	}
 
 	bool operator!=(const label_type& rhs) const {
-		return this->_obj != rhs._obj;
+		return this->_id != rhs._id;
 	}
 
 	friend size_t hash_value(const label_type& label) {
-		return boost::hash_value(label._obj);
+		return label._id;
 	}
 
 	friend std::ostream& operator<<(std::ostream& os, const label_type& label) {
@@ -290,7 +414,7 @@ namespace std
 template <>
 struct hash<label_type> {
 	size_t operator()(const label_type& label) const {
-		return boost::hash_value(label._obj);
+		return label._id;
 	}
 };
 } // namespace
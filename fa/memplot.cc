@@ -19,8 +19,11 @@
 
 // Standard library headers
 #include <cstring>
-#include <fstream>
 #include <libgen.h>
+#include <sstream>
+
+// Code Listener headers
+#include <cl/plotwriter.hh>
 
 // Forester headers
 #include "forestautext.hh"
@@ -300,9 +303,6 @@ class DotPlotVisitor
 {
 private:  // data members
 
-	/// the output stream
-	std::ostream& os_;
-
 	/// the location to be plotted
 	const cl_loc* loc_;
 
@@ -385,8 +385,7 @@ private:  // methods
 
 public:   // methods
 
-	DotPlotVisitor(std::ostream& os, const cl_loc* loc) :
-		os_(os),
+	DotPlotVisitor(const cl_loc* loc) :
 		loc_(loc),
 		vecTreeAut_{},
 		pointers_{}
@@ -452,7 +451,6 @@ public:   // methods
 			{
 				// Assertions
 				assert(nullptr != label.node.v);
-				assert(nullptr != label.node.m);
 
 				const std::vector<const AbstractBox*>& boxes = *label.node.v;
 				const std::vector<SelData>* sels             = label.node.sels;
@@ -543,6 +541,7 @@ public:   // methods
 	}
 
 	void plotMemNode(
+		std::ostream&                           os,
 		const MemNode&                          node,
 		const TreeAutHeap::StateToMemNodeMap&   stateMap)
 	{
@@ -550,7 +549,7 @@ public:   // methods
 		{
 			case MemNode::mem_type::t_block:
 			{
-				os_ << "      " << FA_QUOTE(node.id_)
+				os << "      " << FA_QUOTE(node.id_)
 					<< " [shape=ellipse, style=filled, fillcolor=lightblue, label="
 					<< FA_QUOTE(node.block_.name) << "];\n";
 
@@ -564,7 +563,7 @@ public:   // methods
 
 			case MemNode::mem_type::t_datafield:
 			{
-				os_ << "      " << FA_QUOTE(node.id_)
+				os << "      " << FA_QUOTE(node.id_)
 					<< " [shape=box, style=filled, fillcolor=red, label="
 					<< FA_QUOTE(node.dataField_) << "];\n";
 
@@ -588,11 +587,11 @@ public:   // methods
 			oss << node.id_ << "." << selData.offset;
 			std::string selId = oss.str();
 
-			os_ << "      " << FA_QUOTE(selId)
+			os << "      " << FA_QUOTE(selId)
 				<< " [shape=box, style=filled, fillcolor=pink, label="
 				<< FA_QUOTE(sel.name) << "];\n";
 
-			os_ << "      " << FA_QUOTE(node.id_) << " -> " << FA_QUOTE(selId)
+			os << "      " << FA_QUOTE(node.id_) << " -> " << FA_QUOTE(selId)
 				<< "[label=" << FA_QUOTE("["
 				<< selData.offset << ":"
 				<< selData.size << ":"
@@ -632,7 +631,7 @@ public:   // methods
 		}
 	}
 
-	void plotTreeAutHeapNum(size_t num)
+	void plotTreeAutHeapNum(std::ostream& os, size_t num)
 	{
 		// Assertions
 		assert(num < vecTreeAut_.size());
@@ -643,7 +642,7 @@ public:   // methods
 		{
 			const MemNode& node = stateMemNodePair.second;
 
-			os_ << "    subgraph "
+			os << "    subgraph "
 				<< FA_QUOTE("cluster_treeaut" << num << "_"
 				<< stateToString(stateMemNodePair.first) << "_" << uniqCnt++) << " {\n"
 				<< "      rank=same;\n"
@@ -655,35 +654,35 @@ public:   // methods
 				<< "      style=dashed;\n"
 				<< "      penwidth=1.0;\n\n";
 
-			this->plotMemNode(node, taHeap.getStateMap());
+			this->plotMemNode(os, node, taHeap.getStateMap());
 
-			os_ << "    }\n\n";
+			os << "    }\n\n";
 		}
 	}
 
-	void plotPointers() const
+	void plotPointers(std::ostream& os) const
 	{
 		for (const auto& ptr : pointers_)
 		{
-			os_ << "  " << FA_QUOTE(ptr.src)
+			os << "  " << FA_QUOTE(ptr.src)
 				<< " -> " << FA_QUOTE(ptr.dst);
 
 			if (0 != ptr.offset)
 			{
-				os_ << " [label="
+				os << " [label="
 				<< FA_QUOTE("[" << ((ptr.offset > 0)? "+" : "") << ptr.offset << "]")
 				<< "]";
 			}
 
-			os_ << ";\n";
+			os << ";\n";
 		}
 	}
 
-	void plot()
+	void plot(std::ostream& os)
 	{
 		for (size_t i = 0; i < vecTreeAut_.size(); ++i)
 		{
-			os_ << "  subgraph "
+			os << "  subgraph "
 				<< FA_QUOTE("cluster_treeaut" << i) << " {\n"
 				<< "    rank=same;\n"
 				<< "    label=" << FA_QUOTE("TA " << i) << ";\n"
@@ -694,15 +693,58 @@ public:   // methods
 				<< "    style=dashed;\n"
 				<< "    penwidth=1.0;\n\n";
 
-			this->plotTreeAutHeapNum(i);
+			this->plotTreeAutHeapNum(os, i);
 
-			os_ << "  }\n\n";
+			os << "  }\n\n";
 		}
 
-		this->plotPointers();
+		this->plotPointers(os);
 	}
 };
 
+/// snapshot of a memory graph, formatted by the thread that writes the plot
+class DotPlotJob : public IPlotJob
+{
+private:  // data members
+
+	/// the name of the plot
+	std::string plotName_;
+
+	/// the visitor holding the snapshot of the heap
+	DotPlotVisitor visitor_;
+
+public:   // methods
+
+	DotPlotJob(const std::string& plotName, const cl_loc* loc) :
+		plotName_(plotName),
+		visitor_(loc)
+	{ }
+
+	DotPlotVisitor& visitor()
+	{
+		return visitor_;
+	}
+
+	virtual void format(std::ostream& os)
+	{
+		// open graph
+		os << "digraph " << FA_QUOTE(plotName_) << " {\n"
+			<< "  label=<<FONT POINT-SIZE=\"18\">" << plotName_ << "</FONT>>;\n"
+			<< "  clusterrank=local;\n"
+			<< "  labelloc=t;\n\n";
+
+		visitor_.plot(os);
+
+		// close graph
+		os << "}\n";
+	}
+};
+
+void reportPlotError(const std::string& msg)
+{
+	FA_WARN(msg);
+}
+
 void emitPrototypeError(const struct cl_loc *lw, const char *name)
 {
 	FA_WARN_MSG(lw, "incorrectly called " << name
@@ -808,45 +850,24 @@ std::string MemPlotter::plotHeap(
 	std::string fileName = plotName + ".dot";
 
 	// create a dot file
-	std::fstream out(fileName.c_str(), std::ios::out);
-	if (!out)
+	PlotFile* file = createPlotFile(fileName);
+	if (nullptr == file)
 	{
 		FA_WARN("unable to create file '" << fileName << "'");
 		return fileName;
 	}
 
-	// open graph
-	out << "digraph " << FA_QUOTE(plotName) << " {\n"
-		<< "  label=<<FONT POINT-SIZE=\"18\">" << plotName << "</FONT>>;\n"
-		<< "  clusterrank=local;\n"
-		<< "  labelloc=t;\n\n";
-
-	// check whether we can write to stream
-	if (!out.flush())
-	{
-		FA_WARN("unable to write file '" << fileName << "'");
-		out.close();
-		return fileName;
-	}
-
 	if (loc)
 		FA_NOTE_MSG(loc, "writing memory graph to '" << fileName << "'...");
 	else
 		FA_DEBUG("writing memory graph to '" << fileName << "'...");
 
-	DotPlotVisitor visitor(out, loc);
+	// only take a snapshot of the heap here, plotwriter.hh formats and writes it
+	DotPlotJob* job = new DotPlotJob(plotName, loc);
 
-	state.accept(visitor);
+	state.accept(job->visitor());
 
-	visitor.plot();
-
-	// close graph
-	out << "}\n";
-	if (!out)
-	{
-		FA_WARN("Error writing to file " << fileName);
-	}
-	out.close();
+	writePlotFile(file, job, reportPlotError);
 
 	return fileName;
 }
@@ -71,6 +71,13 @@ void ProgramConfig::processArg(const std::string& arg)
 		return;
 	}
 
+	if (std::string("print-stats") == key)
+	{
+		this->printStats = true;
+		FA_LOG("Config::processArg: \"print-stats\" mode requested");
+		return;
+	}
+
 	//      ***************  binary arguments ****************
 	if (std::string("db-root") == key)
 	{
@@ -84,5 +91,17 @@ void ProgramConfig::processArg(const std::string& arg)
 		return;
 	}
 
+	if (std::string("kernel-log") == key)
+	{
+		if (data.size() != 2)
+		{
+			throw std::invalid_argument("use \"kernel-log:<file>\"");
+		}
+
+		this->kernelLog = data[1];
+		FA_LOG("Config::processArg: \"kernel-log\" is \"" + this->kernelLog + "\"");
+		return;
+	}
+
 	FA_WARN("unhandled argument: \"" << arg << "\"");
 }
@@ -31,11 +31,13 @@ struct ProgramConfig
 public:   // data members
 
 	std::string dbRoot;             ///< box database root directory
+	std::string kernelLog;          ///< file to log kernel inputs into
 	bool        printUcode;         ///< printing microcode?
 	bool        printOrigCode;      ///< printing the original code?
 	bool        onlyCompile;        ///< only compiling?
 	bool        printTrace;         ///< printing trace for errors?
 	bool        printUcodeTrace;    ///< printing microcode trace for errors?
+	bool        printStats;         ///< printing statistics of the analysis?
 
 private:  // methods
 
@@ -45,11 +47,13 @@ public:   // methods
 
 	ProgramConfig(const std::string& confStr = "") :
 		dbRoot(""),
+		kernelLog(""),
 		printUcode(false),
 		printOrigCode(false),
 		onlyCompile(false),
 		printTrace(false),
-		printUcodeTrace(false)
+		printUcodeTrace(false),
+		printStats(false)
 	{
 		std::vector<std::string> args;
 		boost::split(args, confStr, boost::is_any_of(";"));
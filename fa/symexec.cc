@@ -47,6 +47,7 @@ void reportErrorNoLocation(const char* errMsg)
 #include <cl/cldebug.hh>
 #include <cl/clutil.hh>
 #include <cl/code_listener.h>
+#include <cl/memdebug.hh>
 #include <cl/storage.hh>
 #include "../cl/ssd.h"
 
@@ -235,6 +236,26 @@ protected:
 		}
 	}
 
+	/**
+	 * @brief  Prints statistics of the analysis
+	 *
+	 * Prints the statistics on a single line, so that benchmarking scripts can
+	 * easily read them.
+	 */
+	void printStats(size_t restarts, size_t states, size_t paths) const
+	{
+		std::ostringstream os;
+		os << "states " << states << ", paths " << paths
+			<< ", boxes " << boxMan_.boxDatabase().size()
+			<< ", restarts " << restarts;
+
+		long mib;
+		if (peakRssUsage(&mib))
+			os << ", peak-rss " << mib << " MiB";
+
+		FA_NOTE("analysis statistics: " << os.str());
+	}
+
 	/**
 	 * @brief  Clears all fixpoints
 	 */
@@ -581,11 +602,20 @@ public:   // methods
 		// Assertions
 		assert(assembly_.code_.size());
 
+		// the work done by the runs of the analysis that were restarted
+		size_t restarts = 0;
+		size_t states = 0;
+		size_t paths = 0;
+
 		try
 		{	// expect problems...
 			while (!this->mainLoop())
 			{	// while the analysis hasn't terminated
 				FA_NOTE("Restarting the analysis...");
+
+				++restarts;
+				states += execMan_.statesEvaluated();
+				paths += execMan_.pathsEvaluated();
 			}
 
 			FA_NOTE("The program is SAFE.");
@@ -626,6 +656,12 @@ public:   // methods
 
 			throw;
 		}
+
+		if (conf_.printStats)
+		{	// print out the work done by all runs of the analysis
+			this->printStats(restarts, states + execMan_.statesEvaluated(),
+				paths + execMan_.pathsEvaluated());
+		}
 	}
 
 	void run(const Compiler::Assembly& assembly)
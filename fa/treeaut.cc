@@ -305,8 +305,8 @@ void TA<T>::upwardTranslation(
 			// find particular env
 			std::map<Env, size_t>::iterator env =
 				Env::find(LhsEnv::find(lhs, j, lhsEnvSet), label, rhs, envMap);
-			lts.addTransition(lhs[j], labelIndex.size(), env->second);
-			lts.addTransition(env->second, label, rhs);
+			lts.addTransition(lhs[j], labelIndex.size(), env->second + stateIndex.size());
+			lts.addTransition(env->second + stateIndex.size(), label, rhs);
 		}
 	}
 
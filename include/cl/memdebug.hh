@@ -43,4 +43,7 @@ bool printMemUsage(const char *justCompletedFncName);
 /// print the peak over all calls of rawMemUsage(), but relative to the drift
 bool printPeakMemUsage();
 
+/// provide the peak resident set size of the process in MiB (as the OS reports)
+bool peakRssUsage(long *pDst);
+
 #endif /* H_GUARD_MEM_DEBUG_H */
@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef H_GUARD_PLOT_WRITER_H
+#define H_GUARD_PLOT_WRITER_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @file plotwriter.hh
+ * writing of plots off the analysis thread.  The analysis creates the file by
+ * createPlotFile() and takes a snapshot of the graph (an IPlotJob), which is
+ * then formatted and written to disk by a background thread, which takes the
+ * jobs from a bounded queue (see CL_PLOT_WRITER_QUEUE in config_cl.h).
+ * Failures of the background writes are deferred, they are reported (and make
+ * the API return false) on the next call of writePlotFile() or
+ * flushPlotFiles(), whichever comes first.
+ */
+
+/// snapshot of a graph, formatted by the thread that writes the plot to disk
+class IPlotJob {
+    public:
+        virtual ~IPlotJob() { }
+
+        /// format the graph, must not touch any data of the analysis
+        virtual void format(std::ostream &str) = 0;
+};
+
+/// callback formatting an object referenced by PlotRef
+typedef void (*TPlotFormatter)(std::ostream &str, const void *obj);
+
+/**
+ * reference to an object formatted only once the plot is written, the object
+ * has to stay unchanged till flushPlotFiles() (e.g. if owned by CodeStorage)
+ */
+struct PlotRef {
+    TPlotFormatter              fmt;
+    const void                 *obj;
+
+    PlotRef(TPlotFormatter fmt_, const void *obj_):
+        fmt(fmt_),
+        obj(obj_)
+    {
+    }
+};
+
+/**
+ * a plot recorded as a sequence of texts, numbers and object references, which
+ * are converted to text by format().  It is filled as an output stream, except
+ * that no stream manipulators are supported.
+ */
+class PlotRecord: public IPlotJob {
+    public:
+        PlotRecord& operator<<(const char *);
+        PlotRecord& operator<<(const std::string &);
+        PlotRecord& operator<<(char);
+        PlotRecord& operator<<(int);
+        PlotRecord& operator<<(long);
+        PlotRecord& operator<<(long long);
+        PlotRecord& operator<<(unsigned);
+        PlotRecord& operator<<(unsigned long);
+        PlotRecord& operator<<(unsigned long long);
+        PlotRecord& operator<<(double);
+        PlotRecord& operator<<(const void *);
+        PlotRecord& operator<<(const PlotRef &);
+
+        virtual void format(std::ostream &str);
+
+    private:
+        enum EItemKind {
+            PI_TEXT,
+            PI_INT,
+            PI_UINT,
+            PI_REAL,
+            PI_PTR,
+            PI_REF
+        };
+
+        struct TItem {
+            EItemKind                   code;
+            TPlotFormatter              fmt;
+            union {
+                size_t                  len;
+                long long               i;
+                unsigned long long      u;
+                double                  d;
+                const void             *obj;
+            } data;
+        };
+
+        /// all the texts concatenated in the order of their PI_TEXT items
+        std::string                     text_;
+        std::vector<TItem>              items_;
+
+        PlotRecord& addText(const char *str, size_t len);
+        PlotRecord& addInt(long long);
+        PlotRecord& addUInt(unsigned long long);
+        TItem& addItem(EItemKind);
+};
+
+/// callback reporting a failure to write a plot, called on the analysis thread
+typedef void (*TPlotErrorHandler)(const std::string &msg);
+
+/// a file created by createPlotFile()
+struct PlotFile;
+
+/**
+ * create (or truncate) the file for a plot
+ * @return 0 if the file could not be created, it is up to the caller to report
+ * the failure at the level it finds appropriate
+ */
+PlotFile* createPlotFile(const std::string &fileName);
+
+/**
+ * queue the given plot for being formatted and written to the given file
+ * @param file the file created by createPlotFile(), closed once written
+ * @param job snapshot of the graph, deleted once formatted
+ * @param handler reports a failure to write the plot, CL_ERROR() is used if 0
+ * @return false if the plot could not be written (known immediately only if
+ * the plots are written synchronously) or if writing of a previously queued
+ * plot has failed
+ * @note blocks while the queue is full
+ */
+bool writePlotFile(
+        PlotFile                       *file,
+        IPlotJob                       *job,
+        TPlotErrorHandler               handler = 0);
+
+/**
+ * wait until all plots queued so far are written to disk
+ * @return false if writing of any of them has failed and the failure has not
+ * been reported by writePlotFile() yet
+ */
+bool flushPlotFiles();
+
+#endif /* H_GUARD_PLOT_WRITER_H */
@@ -23,6 +23,7 @@
 #include "code_listener.h"
 
 #include <map>
+#include <new>
 #include <set>
 #include <string>
 #include <vector>
@@ -672,6 +673,8 @@ class Node {
         TNodeList                       inNodes;
         /// there should be only one black-hole / graph
         bool                            isBlackHole;
+        /// node this one was joined into (NULL if not joined), see findRepS()
+        Node                           *joinedTo;
 };
 
 // In some types of PT-graphs (e.g. graph constructed by FICS algorithm) we can
@@ -818,7 +821,15 @@ class FncDb {
 
 typedef std::vector<const Fnc *>                    TFncList;
 typedef std::vector<const Insn *>                   TInsnList;
-typedef std::map<Fnc *, TInsnList>                  TInsnListByFnc;
+/**
+ * order functions by their uids (a zero key goes first), such that iterating
+ * over the call graph does not depend on where the Fnc objects are allocated
+ */
+struct FncUidLess {
+    bool operator()(const Fnc *, const Fnc *) const;
+};
+
+typedef std::map<Fnc *, TInsnList, FncUidLess>      TInsnListByFnc;
 
 namespace CallGraph {
 
@@ -861,10 +872,50 @@ namespace CallGraph {
 
 } // namespace CallGraph
 
+/**
+ * memory pool for the objects owned by Storage (instructions, deep-cloned
+ * operands, accessors and strings).  The objects are allocated sequentially in
+ * big chunks and all of them are released at once when the pool is destroyed.
+ * @note destructors of the objects are @b not called by the pool
+ */
+class Arena {
+    public:
+        Arena();
+        ~Arena();
+
+        /// allocate a (suitably aligned) block of the given size
+        void* alloc(size_t size);
+
+        /// construct a value-initialized object in the pool
+        template <class T> T* create() {
+            return new (this->alloc(sizeof(T))) T();
+        }
+
+        /// construct a copy of the given object in the pool
+        template <class T> T* create(const T &tpl) {
+            return new (this->alloc(sizeof(T))) T(tpl);
+        }
+
+        /// duplicate the given zero-terminated string (NULL results in NULL)
+        const char* dupString(const char *str);
+
+        /// count of bytes allocated from the system so far
+        size_t size() const;
+
+    private:
+        // not copyable
+        Arena(const Arena &);
+        Arena& operator=(const Arena &);
+
+        struct Private;
+        Private *d;
+};
+
 /**
  * a value type representing the @b whole @b serialised @b model of code
  */
 struct Storage {
+    Arena                       arena;      ///< owns insns, operands and such
     TypeDb                      types;      ///< type info lookup container
     VarDb                       vars;       ///< variables lookup container
     FncDb                       fncs;       ///< functions lookup container
@@ -27,11 +27,13 @@
 
 #include "fixed_point_proxy.hh"
 #include "glconf.hh"
+#include "resgov.hh"
 #include "symbt.hh"
 #include "symdump.hh"
 #include "symexec.hh"
 #include "symproc.hh"
 #include "symstate.hh"
+#include "symstats.hh"
 #include "symtrace.hh"
 #include "util.hh"
 
@@ -105,6 +107,14 @@ void execVirtualRoots(const CodeStorage::Storage &stor)
 
     // go through all root nodes
     const CG::Graph &cg = stor.callGraph;
+
+    FixedPoint::StateByInsn *const fixedPoint = GlConf::data.fixedPoint;
+    if (fixedPoint) {
+        // keep the fixed-points of fncs called by the remaining roots in memory
+        BOOST_FOREACH(const CG::Node *node, cg.roots)
+            fixedPoint->expectRoot(node->fnc);
+    }
+
     BOOST_FOREACH(const CG::Node *node, cg.roots) {
         const CodeStorage::Fnc &fnc = *node->fnc;
         CL_BREAK_IF(!isDefined(fnc));
@@ -157,6 +167,11 @@ void clEasyRun(const CodeStorage::Storage &stor, const char *configString)
     GlConf::loadConfigString(configString);
 
     // run symbolic execution
+    ResGovernor::start();
+    SymStats::reset();
+
+    // the ranks of blocks from a previously analyzed Storage are not valid
+    BlockScheduler::resetRanking();
     try {
         launchSymExec(stor);
     }
@@ -164,6 +179,12 @@ void clEasyRun(const CodeStorage::Storage &stor, const char *configString)
         CL_DEBUG("clEasyRun() caught a run-time exception: " << e.what());
     }
 
+    // report the budgets hit by the analysis (if any)
+    ResGovernor::printReport();
+
+    if (GlConf::data.printStats)
+        SymStats::printReport();
+
     FixedPoint::StateByInsn *const fixedPoint = GlConf::data.fixedPoint;
     if (fixedPoint) {
         // plot fixed-point
@@ -28,6 +28,12 @@
 #define GIT_SHA1 sl_git_sha1
 #include "trap.h"
 
+/**
+ * if 1, check the cached results of segment discovery against a discovery from
+ * scratch in each abstraction step (expensive)
+ */
+#define DEBUG_SEG_DISCOVERY_CACHE           0
+
 /**
  * if 1, print block scheduler statistics whenever end of a fnc is not reached
  */
@@ -98,6 +104,12 @@
  */
 #define SE_ALLOW_SUBPATH_RANKING            0
 
+/**
+ * if 1, reuse the results of segment discovery in between abstraction steps
+ * except those that can be affected by the step (see DEBUG_SEG_DISCOVERY_CACHE)
+ */
+#define SE_INCREMENTAL_SEG_DISCOVERY        1
+
 /**
  * bit mask of allowed operations on integral ranges
  * - 0x1 ... allow to create integral ranges from integral constants if needed
@@ -133,6 +145,9 @@
  * - 1 ... use DFS scheduler, keep already scheduled blocks at their position
  * - 2 ... use DFS scheduler, move already scheduled blocks to front of queue
  * - 3 ... use load-driven scheduler (picks the one with fewer pending heaps)
+ * - 4 ... use priority-driven scheduler (inner loops first, then CFG RPO)
+ * - 5 ... like 4 but delay loop heads until the rest of the loop is done
+ * @note the kind can be overridden at run-time by the block_scheduler option
  */
 #define SE_BLOCK_SCHEDULER_KIND             2
 
@@ -298,6 +313,11 @@
  */
 #define SH_DELAYED_FIELDS_DESTRUCTION       1
 
+/**
+ * if 1, allocate heap entities from slabs, with a free list per size class
+ */
+#define SH_ENT_POOL                         1
+
 /**
  * if more than zero, jump to debugger as soon as N graph of the same name has
  * been plotted
@@ -29,14 +29,8 @@
 #include <climits>                  // for INT_MIN/INT_MAX
 #include <utility>
 
-namespace CodeStorage {
-    class Fnc;
-}
-
 namespace FixedPoint {
 
-typedef const CodeStorage::Fnc                     *TFnc;
-
 typedef int                                         TLocIdx;
 typedef int                                         THeapIdx;
 typedef int                                         TShapeIdx;
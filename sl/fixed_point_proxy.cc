@@ -26,14 +26,17 @@
 #include "cont_shape_seq.hh"
 #include "fixed_point.hh"
 #include "symplot.hh"
+#include "worklist.hh"
 
 #include <cl/cl_msg.hh>
 #include <cl/cldebug.hh>
+#include <cl/plotwriter.hh>
 #include <cl/storage.hh>
 
-#include <fstream>
 #include <iomanip>
 #include <map>
+#include <set>
+#include <sstream>
 
 #include <boost/foreach.hpp>
 
@@ -42,12 +45,37 @@ namespace FixedPoint {
 typedef const struct cl_loc                        *TLoc;
 typedef int                                         TFncUid;
 typedef std::map<TFncUid, TFnc>                     TFncMap;
+typedef std::vector<TFnc>                           TFncList;
+typedef std::set<TFnc>                              TFncSet;
+typedef std::map<TFnc, TFncSet>                     TReachMap;
+typedef std::map<TFnc, std::vector<TInsn> >         TInsnsByFnc;
 
 typedef const CodeStorage::Block                   *TBlock;
 
 struct StateByInsn::Private {
     TFncMap             visitedFncs;
     TStateMap           stateByInsn;
+    TInsnsByFnc         insnsByFnc;
+    TFncList            frames;
+    TFncSet             expectedRoots;
+    std::set<TFncUid>   plottedFncs;
+    bool                adtOpsLoaded;
+
+    /// functions callable (transitively) from the key, computed on demand
+    TReachMap           reachable;
+
+    /// functions that can call an unknown function (transitively)
+    TFncSet             reachAny;
+
+    Private():
+        adtOpsLoaded(false)
+    {
+    }
+
+    const TFncSet* callableFrom(const TFnc);
+    bool isCallable(const TFnc);
+    void plotFinished(const TFnc);
+    void plotAndRelease(const TFnc);
 };
 
 StateByInsn::StateByInsn():
@@ -69,6 +97,10 @@ bool /* any change */ StateByInsn::insert(const TInsn insn, const SymHeap &sh)
         const TFnc fnc = fncByCfg(insn->bb->cfg());
         const TFncUid uid = uidOf(*fnc);
         d->visitedFncs[uid] = fnc;
+        d->insnsByFnc[fnc].push_back(insn);
+
+        // the fixed-point of a plotted function is not expected to grow
+        CL_BREAK_IF(hasKey(d->plottedFncs, uid));
     }
 
     return state.insert(sh, /* allowThreeWay */ false);
@@ -80,12 +112,12 @@ const StateByInsn::TStateMap& StateByInsn::stateMap() const
 }
 
 struct PlotData {
-    std::ostream                   &out;
+    PlotRecord                     &out;
     StateByInsn::TStateMap         &stateByInsn;
     std::string                     name;
 
     PlotData(
-            std::ostream           &out_,
+            PlotRecord             &out_,
             StateByInsn::TStateMap &stateByInsn_,
             const std::string      &name_):
         out(out_),
@@ -101,6 +133,20 @@ struct PlotData {
 #define DOT_LINK(to) "\"" << to << ".svg\""
 #define STD_SETW(n) std::fixed << std::setfill('0') << std::setw(n)
 
+// the instructions are owned by CodeStorage, we can format them in plotwriter
+void formatInsn(std::ostream &str, const void *obj)
+{
+    str << *static_cast<TInsn>(obj);
+}
+
+void formatInsnLoc(std::ostream &str, const void *obj)
+{
+    str << static_cast<TInsn>(obj)->loc;
+}
+
+#define INSN(insn)      PlotRef(formatInsn, insn)
+#define INSN_LOC(insn)  PlotRef(formatInsnLoc, insn)
+
 void plotInsn(PlotData &plot, const TLocIdx locIdx, const LocalState &locState)
 {
     const TInsn insn = locState.insn;
@@ -110,8 +156,8 @@ void plotInsn(PlotData &plot, const TLocIdx locIdx, const LocalState &locState)
         << "\" {\n\tlabel=\"loc #" << locIdx << "\";\n";
 
     // plot the root node
-    plot.out << LOC_NODE(locIdx) << " [label=" << QUOT(*insn)
-        << ", tooltip=" << QUOT(insn->loc)
+    plot.out << LOC_NODE(locIdx) << " [label=" << QUOT(INSN(insn))
+        << ", tooltip=" << QUOT(INSN_LOC(insn))
         << ", shape=box, color=blue, fontcolor=blue];\n";
 
     const SymState &state = locState.heapList;
@@ -217,50 +263,179 @@ void plotFnc(const TFnc fnc, StateByInsn::TStateMap &stateByInsn)
 
     // create a dot file
     const std::string fileName(plotName + ".dot");
-    std::fstream out(fileName.c_str(), std::ios::out);
-    if (!out) {
+    PlotFile *file = createPlotFile(fileName);
+    if (!file) {
         CL_ERROR("unable to create file '" << fileName << "'");
         return;
     }
 
+    // the graph is only recorded here, plotwriter.hh formats and writes it
+    PlotRecord *out = new PlotRecord;
+
     // open graph
-    out << "digraph " << QUOT(plotName)
+    *out << "digraph " << QUOT(plotName)
         << " {\n\tlabel=<<FONT POINT-SIZE=\"36\">" << fncName
         << "()</FONT>>;\n\tclusterrank=local;\n\tlabelloc=t;\n";
 
     // plot the body
-    PlotData plot(out, stateByInsn, plotName);
+    PlotData plot(*out, stateByInsn, plotName);
     const GlobalState *fncState = computeStateOf(fnc, stateByInsn);
     plotFncCore(plot, *fncState);
     delete fncState;
 
     // close graph
-    out << "}\n";
-    if (!out)
-        CL_ERROR("unable to write file '" << fileName << "'");
-    out.close();
+    *out << "}\n";
+    writePlotFile(file, out);
 }
 
-void StateByInsn::plotAll()
+void StateByInsn::Private::plotAndRelease(const TFnc fnc)
 {
-    if (d->visitedFncs.empty())
+    if (!this->adtOpsLoaded) {
+        // XXX
+        AdtOp::loadDefaultOperations(&adtOps, *fnc->stor);
+        adtOps.plot();
+        this->adtOpsLoaded = true;
+    }
+
+    const TLoc loc = locationOf(*fnc);
+    CL_NOTE_MSG(loc, "plotting fixed-point of " << nameOf(*fnc) << "()...");
+    plotFnc(fnc, this->stateByInsn);
+
+    // release the heaps of the plotted function
+    const TInsnsByFnc::iterator it = this->insnsByFnc.find(fnc);
+    if (this->insnsByFnc.end() != it) {
+        BOOST_FOREACH(const TInsn insn, it->second)
+            this->stateByInsn.erase(insn);
+
+        this->insnsByFnc.erase(it);
+    }
+
+    const TFncUid uid = uidOf(*fnc);
+    this->visitedFncs.erase(uid);
+    this->plottedFncs.insert(uid);
+}
+
+/// functions callable from root (memoized), NULL if any function can be called
+const TFncSet* StateByInsn::Private::callableFrom(const TFnc root)
+{
+    if (hasKey(this->reachAny, root))
+        return 0;
+
+    const TReachMap::const_iterator it = this->reachable.find(root);
+    if (this->reachable.end() != it)
+        return &it->second;
+
+    typedef CodeStorage::TInsnListByFnc TCallMap;
+    TFncSet &dst = this->reachable[root];
+    WorkList<TFnc> wl(root);
+
+    TFnc fnc;
+    bool complete = true;
+    while (complete && wl.next(fnc)) {
+        dst.insert(fnc);
+
+        const CodeStorage::CallGraph::Node *cgNode = fnc->cgNode;
+        if (!cgNode) {
+            // call graph not available
+            complete = false;
+            break;
+        }
+
+        BOOST_FOREACH(TCallMap::const_reference call, cgNode->calls) {
+            const TFnc callee = call.first;
+            if (!callee) {
+                // indirect call, any function can be called from here
+                complete = false;
+                break;
+            }
+
+            wl.schedule(callee);
+        }
+    }
+
+    if (complete)
+        return &dst;
+
+    this->reachable.erase(root);
+    this->reachAny.insert(root);
+    return 0;
+}
+
+/// true if fnc can still be called during the analysis
+bool StateByInsn::Private::isCallable(const TFnc fnc)
+{
+    TFncList roots(this->frames);
+    roots.insert(roots.end(),
+            this->expectedRoots.begin(),
+            this->expectedRoots.end());
+
+    BOOST_FOREACH(const TFnc root, roots) {
+        const TFncSet *callable = this->callableFrom(root);
+        if (!callable || hasKey(*callable, fnc))
+            return true;
+    }
+
+    return false;
+}
+
+void StateByInsn::Private::plotFinished(const TFnc left)
+{
+    if (this->visitedFncs.empty())
         // nothing to plot
         return;
 
-    // obtain a reference to CodeStorage::Storage
-    TStorRef stor = *d->visitedFncs.begin()->second->stor;
-
-    // XXX
-    AdtOp::loadDefaultOperations(&adtOps, stor);
-    adtOps.plot();
+    // only the functions callable from the one we have left could have become
+    // uncallable, unless it could call any function
+    TFncMap candidates;
+    const TFncSet *callable = this->callableFrom(left);
+    if (callable) {
+        BOOST_FOREACH(const TFnc fnc, *callable) {
+            const TFncUid uid = uidOf(*fnc);
+            if (hasKey(this->visitedFncs, uid))
+                candidates[uid] = fnc;
+        }
+    }
+    else
+        candidates = this->visitedFncs;
 
-    BOOST_FOREACH(TFncMap::const_reference fncItem, d->visitedFncs) {
+    // plot the functions in the order of their uids (deterministic output)
+    TFncList finished;
+    BOOST_FOREACH(TFncMap::const_reference fncItem, candidates) {
         const TFnc fnc = fncItem.second;
-        const TLoc loc = locationOf(*fnc);
-        CL_NOTE_MSG(loc, "plotting fixed-point of " << nameOf(*fnc) << "()...");
-
-        plotFnc(fnc, d->stateByInsn);
+        if (!this->isCallable(fnc))
+            finished.push_back(fnc);
     }
+
+    BOOST_FOREACH(const TFnc fnc, finished)
+        this->plotAndRelease(fnc);
+}
+
+void StateByInsn::expectRoot(const TFnc fnc)
+{
+    d->expectedRoots.insert(fnc);
+}
+
+void StateByInsn::enterFnc(const TFnc fnc)
+{
+    if (d->frames.empty())
+        // the root function is no longer expected once we have entered it
+        d->expectedRoots.erase(fnc);
+
+    d->frames.push_back(fnc);
+}
+
+void StateByInsn::leaveFnc(const TFnc fnc)
+{
+    CL_BREAK_IF(d->frames.empty() || d->frames.back() != fnc);
+    d->frames.pop_back();
+    d->plotFinished(fnc);
+}
+
+void StateByInsn::plotAll()
+{
+    // plot the remainder regardless of the call graph
+    while (!d->visitedFncs.empty())
+        d->plotAndRelease(d->visitedFncs.begin()->second);
 }
 
 } // namespace FixedPoint
@@ -25,11 +25,13 @@
 #include <map>
 
 namespace CodeStorage {
+    struct Fnc;
     struct Insn;
 }
 
 namespace FixedPoint {
 
+    typedef const CodeStorage::Fnc         *TFnc;
     typedef const CodeStorage::Insn        *TInsn;
 
     class StateByInsn {
@@ -41,8 +43,26 @@ namespace FixedPoint {
 
             bool /* any change */ insert(const TInsn insn, const SymHeap &sh);
 
+            /**
+             * the states of the functions not plotted yet, the heaps of
+             * plotted functions are released by leaveFnc() and plotAll()
+             */
             const TStateMap& stateMap() const;
 
+            /// announce a root function going to be executed later on
+            void expectRoot(const TFnc);
+
+            /// to be called on entry to each function call being executed
+            void enterFnc(const TFnc);
+
+            /**
+             * to be called once a function call is done, the fixed-points of
+             * all functions that can no longer be called are plotted right
+             * away and their heaps released
+             */
+            void leaveFnc(const TFnc);
+
+            /// plot the fixed-points of all functions not plotted yet
             void plotAll();
 
         private:
@@ -25,6 +25,9 @@
 #include <cl/cl_msg.hh>
 
 #include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
 #include <map>
 #include <vector>
 
@@ -57,6 +60,44 @@ void assumeNoValue(const string &name, const string &value)
     CL_WARN("option \"" << name << "\" takes no value");
 }
 
+/// parse a decimal number, return false if the value is not a valid number
+bool parseNumber(long *pDst, const string &value)
+{
+    if (value.empty())
+        return false;
+
+    char *end;
+    errno = 0;
+    const long num = strtol(value.c_str(), &end, 10);
+    if (errno || *end)
+        return false;
+
+    *pDst = num;
+    return true;
+}
+
+void handleBlockScheduler(const string &name, const string &value)
+{
+    long kind;
+    if (!parseNumber(&kind, value) || kind < 0 || 5 < kind) {
+        CL_WARN("ignoring option \"" << name << "\" without a valid value");
+        return;
+    }
+
+    data.blockSchedulerKind = kind;
+}
+
+void readLimit(int *pDst, const string &name, const string &value)
+{
+    long limit;
+    if (!parseNumber(&limit, value) || limit <= 0 || INT_MAX < limit) {
+        CL_WARN("ignoring option \"" << name << "\" without a valid value");
+        return;
+    }
+
+    *pDst = limit;
+}
+
 void handleDumpFixedPoint(const string &name, const string &value)
 {
     assumeNoValue(name, value);
@@ -76,6 +117,11 @@ void handleErrorLabel(const string &name, const string &value)
     data.errLabel = value;
 }
 
+void handleMemLimit(const string &name, const string &value)
+{
+    readLimit(&data.memLimit, name, value);
+}
+
 void handleNoErrorRecovery(const string &name, const string &value)
 {
     assumeNoValue(name, value);
@@ -94,6 +140,22 @@ void handleOOM(const string &name, const string &value)
     data.oomSimulation = true;
 }
 
+void handlePrintStats(const string &name, const string &value)
+{
+    assumeNoValue(name, value);
+    data.printStats = true;
+}
+
+void handleStateLimit(const string &name, const string &value)
+{
+    readLimit(&data.stateLimit, name, value);
+}
+
+void handleTimeLimit(const string &name, const string &value)
+{
+    readLimit(&data.timeLimit, name, value);
+}
+
 void handleTrackUninit(const string &name, const string &value)
 {
     assumeNoValue(name, value);
@@ -102,11 +164,16 @@ void handleTrackUninit(const string &name, const string &value)
 
 ConfigStringParser::ConfigStringParser()
 {
+    tbl_["block_scheduler"]         = handleBlockScheduler;
     tbl_["dump_fixed_point"]        = handleDumpFixedPoint;
     tbl_["error_label"]             = handleErrorLabel;
+    tbl_["mem_limit"]               = handleMemLimit;
     tbl_["no_error_recovery"]       = handleNoErrorRecovery;
     tbl_["no_plot"]                 = handleNoPlot;
     tbl_["oom"]                     = handleOOM;
+    tbl_["print_stats"]             = handlePrintStats;
+    tbl_["state_limit"]             = handleStateLimit;
+    tbl_["time_limit"]              = handleTimeLimit;
     tbl_["track_uninit"]            = handleTrackUninit;
 }
 
@@ -34,7 +34,12 @@ struct Options {
     bool trackUninit;       ///< enable/disable @b track_uninit @b mode
     bool oomSimulation;     ///< enable/disable @b oom @b simulation mode
     bool skipUserPlots;     ///< ignore all ___sl_plot*() calls
+    bool printStats;        ///< print the counters of SymStats at the end
     int errorRecoveryMode;  ///< @copydoc config.h::SE_ERROR_RECOVERY_MODE
+    int blockSchedulerKind; ///< @copydoc config.h::SE_BLOCK_SCHEDULER_KIND
+    int timeLimit;          ///< time budget in seconds (0 means unlimited)
+    int memLimit;           ///< memory budget in MiB (0 means unlimited)
+    int stateLimit;         ///< max count of heaps per block (0 = unlimited)
     std::string errLabel;   ///< if not empty, treat reaching the label as error
     FixedPoint::StateByInsn *fixedPoint;  ///< fixed-point plotter (0 if unused)
 
@@ -42,7 +47,12 @@ struct Options {
         trackUninit(false),
         oomSimulation(false),
         skipUserPlots(false),
+        printStats(false),
         errorRecoveryMode(SE_ERROR_RECOVERY_MODE),
+        blockSchedulerKind(SE_BLOCK_SCHEDULER_KIND),
+        timeLimit(0),
+        memLimit(0),
+        stateLimit(0),
         fixedPoint(0)
     {
     }
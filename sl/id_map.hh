@@ -0,0 +1,357 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef H_GUARD_ID_MAP_H
+#define H_GUARD_ID_MAP_H
+
+/**
+ * @file id_map.hh
+ * IdMap, IdPairMap - lookup tables indexed by the (dense) IDs of SymHeap
+ * entities, cleared in constant time by bumping their generation stamp
+ */
+
+#include "config.h"
+
+#include <algorithm>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include <boost/foreach.hpp>
+
+/**
+ * lookup table indexed directly by non-negative IDs, negative IDs are rare and
+ * thus stored aside in an ordinary std::map
+ * @note The interface mimics std::map as long as lookups are concerned.  There
+ * is no support for iteration though.  An iterator obtained by find() is
+ * invalidated by the subsequent insertion of a new key.
+ */
+template <typename TKey, typename TVal>
+class IdMap {
+    public:
+        // for compatibility with STL
+        typedef TKey                                    key_type;
+        typedef TVal                                    mapped_type;
+        typedef std::pair<TKey, TVal>                   value_type;
+        typedef value_type                             *iterator;
+        typedef const value_type                       *const_iterator;
+
+    public:
+        IdMap():
+            gen_(1U),
+            size_(0U)
+        {
+        }
+
+        bool empty() const                  { return !size_; }
+        unsigned size() const               { return size_; }
+
+        iterator end()                      { return 0; }
+        const_iterator end() const          { return 0; }
+
+        iterator find(const TKey key) {
+            const IdMap &self = *this;
+            return const_cast<iterator>(self.find(key));
+        }
+
+        const_iterator find(const TKey key) const;
+
+        TVal& operator[](const TKey key);
+
+        unsigned erase(const TKey key);
+
+        void clear();
+
+    private:
+        struct Slot {
+            unsigned                                    gen;
+            value_type                                  item;
+
+            Slot(): gen(0U) { }
+        };
+
+        typedef std::vector<Slot>                       TSlots;
+        typedef std::map<TKey, value_type>              TSpill;
+
+        unsigned                                        gen_;
+        unsigned                                        size_;
+        TSlots                                          slots_;
+        TSpill                                          spill_;
+};
+
+template <typename TKey, typename TVal>
+typename IdMap<TKey, TVal>::const_iterator
+IdMap<TKey, TVal>::find(const TKey key) const
+{
+    if (key < 0) {
+        const typename TSpill::const_iterator it = spill_.find(key);
+        return (spill_.end() == it)
+            ? 0
+            : &it->second;
+    }
+
+    const unsigned idx = static_cast<unsigned>(key);
+    if (slots_.size() <= idx)
+        return 0;
+
+    const Slot &slot = slots_[idx];
+    return (gen_ == slot.gen)
+        ? &slot.item
+        : 0;
+}
+
+template <typename TKey, typename TVal>
+TVal& IdMap<TKey, TVal>::operator[](const TKey key)
+{
+    if (key < 0) {
+        value_type &item = spill_[key];
+        if (item.first != key) {
+            // a newly inserted key
+            item.first = key;
+            ++size_;
+        }
+
+        return item.second;
+    }
+
+    const unsigned idx = static_cast<unsigned>(key);
+    if (slots_.size() <= idx)
+        slots_.resize(std::max<unsigned>(idx + 1U, 2U * slots_.size()));
+
+    Slot &slot = slots_[idx];
+    if (gen_ != slot.gen) {
+        // a newly inserted key
+        slot.gen = gen_;
+        slot.item = value_type(key, TVal());
+        ++size_;
+    }
+
+    return slot.item.second;
+}
+
+template <typename TKey, typename TVal>
+unsigned IdMap<TKey, TVal>::erase(const TKey key)
+{
+    if (key < 0) {
+        if (!spill_.erase(key))
+            return 0U;
+    }
+    else {
+        const unsigned idx = static_cast<unsigned>(key);
+        if (slots_.size() <= idx || gen_ != slots_[idx].gen)
+            return 0U;
+
+        slots_[idx].gen = 0U;
+    }
+
+    --size_;
+    return 1U;
+}
+
+template <typename TKey, typename TVal>
+void IdMap<TKey, TVal>::clear()
+{
+    spill_.clear();
+    size_ = 0U;
+
+    if (++gen_)
+        // all slots have been invalidated by bumping the generation stamp
+        return;
+
+    // the generation stamp has wrapped around, we need to reset the slots
+    BOOST_FOREACH(Slot &slot, slots_)
+        slot.gen = 0U;
+
+    gen_ = 1U;
+}
+
+/**
+ * open-addressing hash table with linear probing, indexed by pairs of IDs
+ * @note The same restrictions as for IdMap apply.
+ */
+template <typename TKey, typename TVal>
+class IdPairMap {
+    public:
+        // for compatibility with STL
+        typedef std::pair<TKey, TKey>                   key_type;
+        typedef TVal                                    mapped_type;
+        typedef std::pair<key_type, TVal>               value_type;
+        typedef value_type                             *iterator;
+        typedef const value_type                       *const_iterator;
+
+    public:
+        IdPairMap():
+            gen_(1U),
+            size_(0U),
+            slots_(/* initial capacity */ 0x40)
+        {
+        }
+
+        bool empty() const                  { return !size_; }
+        unsigned size() const               { return size_; }
+
+        iterator end()                      { return 0; }
+        const_iterator end() const          { return 0; }
+
+        iterator find(const key_type &key) {
+            const IdPairMap &self = *this;
+            return const_cast<iterator>(self.find(key));
+        }
+
+        const_iterator find(const key_type &key) const {
+            const Slot &slot = slots_[this->lookup(key)];
+            return (gen_ == slot.gen)
+                ? &slot.item
+                : 0;
+        }
+
+        TVal& operator[](const key_type &key);
+
+        void clear();
+
+    private:
+        struct Slot {
+            unsigned                                    gen;
+            value_type                                  item;
+
+            Slot(): gen(0U) { }
+        };
+
+        typedef std::vector<Slot>                       TSlots;
+
+        unsigned                                        gen_;
+        unsigned                                        size_;
+        TSlots                                          slots_;
+
+        static unsigned hash(const key_type &key) {
+            const unsigned a = static_cast<unsigned>(key.first);
+            const unsigned b = static_cast<unsigned>(key.second);
+            return (a * 0x9E3779B1U) ^ (b + 0x7F4A7C15U + (a << 6) + (a >> 2));
+        }
+
+        /// return index of the slot holding key, or the free slot to hold it
+        unsigned lookup(const key_type &key) const;
+
+        void grow();
+};
+
+template <typename TKey, typename TVal>
+unsigned IdPairMap<TKey, TVal>::lookup(const key_type &key) const
+{
+    // the capacity is always a power of two
+    const unsigned mask = slots_.size() - 1U;
+
+    unsigned idx = hash(key) & mask;
+    for (;;) {
+        const Slot &slot = slots_[idx];
+        if (gen_ != slot.gen || key == slot.item.first)
+            return idx;
+
+        idx = (idx + 1U) & mask;
+    }
+}
+
+template <typename TKey, typename TVal>
+TVal& IdPairMap<TKey, TVal>::operator[](const key_type &key)
+{
+    unsigned idx = this->lookup(key);
+    if (gen_ == slots_[idx].gen)
+        // key found
+        return slots_[idx].item.second;
+
+    if (slots_.size() < 2U * (size_ + 1U)) {
+        // keep the load factor below 1/2
+        this->grow();
+        idx = this->lookup(key);
+    }
+
+    Slot &slot = slots_[idx];
+    slot.gen = gen_;
+    slot.item = value_type(key, TVal());
+    ++size_;
+    return slot.item.second;
+}
+
+template <typename TKey, typename TVal>
+void IdPairMap<TKey, TVal>::grow()
+{
+    TSlots old(2U * slots_.size());
+    old.swap(slots_);
+
+    const unsigned genOld = gen_;
+    gen_ = 1U;
+    size_ = 0U;
+
+    BOOST_FOREACH(const Slot &slot, old) {
+        if (genOld != slot.gen)
+            continue;
+
+        Slot &dst = slots_[this->lookup(slot.item.first)];
+        dst.gen = gen_;
+        dst.item = slot.item;
+        ++size_;
+    }
+}
+
+template <typename TKey, typename TVal>
+void IdPairMap<TKey, TVal>::clear()
+{
+    size_ = 0U;
+
+    if (++gen_)
+        // all slots have been invalidated by bumping the generation stamp
+        return;
+
+    // the generation stamp has wrapped around, we need to reset the slots
+    BOOST_FOREACH(Slot &slot, slots_)
+        slot.gen = 0U;
+
+    gen_ = 1U;
+}
+
+/// keeps instances of T in between their uses to avoid repeated allocation
+template <class T>
+class IdMapRecycler {
+    public:
+        ~IdMapRecycler() {
+            BOOST_FOREACH(T *obj, free_)
+                delete obj;
+        }
+
+        /// return an instance of T, cleared by the last call of recycle()
+        T* alloc() {
+            if (free_.empty())
+                return new T;
+
+            T *obj = free_.back();
+            free_.pop_back();
+            return obj;
+        }
+
+        /// give the instance back for later reuse, T::clear() is called on it
+        void recycle(T *obj) {
+            obj->clear();
+            free_.push_back(obj);
+        }
+
+    private:
+        std::vector<T *>                                free_;
+};
+
+#endif /* H_GUARD_ID_MAP_H */
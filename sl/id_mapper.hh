@@ -22,9 +22,9 @@
 
 #include "config.h"
 
+#include <algorithm>
 #include <iostream>
 #include <limits>
-#include <set>
 #include <vector>
 
 #include <boost/foreach.hpp>
@@ -89,7 +89,9 @@ class IdMapper {
 
     private:
         typedef std::pair<TId, TId>                 TPair;
-        typedef std::set<TPair>                     TSearch;
+
+        /// lexicographically sorted vector of pairs, without duplicates
+        typedef std::vector<TPair>                  TSearch;
         typedef TSearch                             TBidirSearch[2];
         typedef typename TSearch::const_iterator    TIter;
 
@@ -116,13 +118,20 @@ bool IdMapper<TId, MIN, MAX>::insert(const TId left, const TId right)
 {
     const TPair itemL(left, right);
     const TPair itemR(right, left);
-    CL_BREAK_IF(hasKey(biSearch_[0], itemL) != hasKey(biSearch_[1], itemR));
 
-    const bool changed = biSearch_[D_LEFT_TO_RIGHT].insert(itemL).second;
-    if (!changed)
+    TSearch &ltr = biSearch_[D_LEFT_TO_RIGHT];
+    TSearch &rtl = biSearch_[D_RIGHT_TO_LEFT];
+    CL_BREAK_IF(std::binary_search(ltr.begin(), ltr.end(), itemL)
+            != std::binary_search(rtl.begin(), rtl.end(), itemR));
+
+    const typename TSearch::iterator itL =
+        std::lower_bound(ltr.begin(), ltr.end(), itemL);
+    if (itL != ltr.end() && *itL == itemL)
+        // already mapped
         return false;
 
-    biSearch_[D_RIGHT_TO_LEFT].insert(itemR);
+    ltr.insert(itL, itemL);
+    rtl.insert(std::lower_bound(rtl.begin(), rtl.end(), itemR), itemR);
     return true;
 }
 
@@ -135,7 +144,7 @@ void IdMapper<TId, MIN, MAX>::query(TVector *pDst, const TId id) const
     const TSearch &search = biSearch_[DIR];
 
     const TPair begItem(id, MIN);
-    const TIter beg = search.lower_bound(begItem);
+    const TIter beg = std::lower_bound(search.begin(), search.end(), begItem);
     if (beg == search.end() || beg->first != id) {
         // not found
         switch (nfa_) {
@@ -154,7 +163,7 @@ void IdMapper<TId, MIN, MAX>::query(TVector *pDst, const TId id) const
 
     // find last (end points one item _beyond_ the last one)
     const TPair endItem(id, MAX);
-    const TIter end = search.upper_bound(endItem);
+    const TIter end = std::upper_bound(beg, search.end(), endItem);
     CL_BREAK_IF(beg == end);
 
     // copy the image to the given vector
@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+#include "resgov.hh"
+
+#include "glconf.hh"
+
+#include <cl/cl_msg.hh>
+#include <cl/memdebug.hh>
+
+#include <ctime>
+
+enum EBudget {
+    BT_TIME = 0,
+    BT_MEM,
+    BT_STATE,
+    BT_TOTAL
+};
+
+struct Budget {
+    const char             *name;
+    const char             *unit;
+    int GlConf::Options::*  limit;      ///< the option giving the budget
+    EGovLevel               hitLevel;   ///< the cheapest settings it caused
+    long                    hitValue;   ///< the amount that caused hitLevel
+};
+
+static Budget budgets[BT_TOTAL] = {
+    { "time",   " s",       &GlConf::Options::timeLimit,    GL_FULL, 0L },
+    { "memory", " MiB",     &GlConf::Options::memLimit,     GL_FULL, 0L },
+    { "state",  " heaps",   &GlConf::Options::stateLimit,   GL_FULL, 0L }
+};
+
+/// percentage of a budget that makes us leave the given level
+static const long pctByLevel[GL_GIVE_UP] = { 50L, 75L, 100L };
+
+static EGovLevel govLevel;
+static time_t startTime;
+
+static const char* describeLevel(const EGovLevel level)
+{
+    switch (level) {
+        case GL_FULL:
+            return "no change of settings";
+
+        case GL_JOIN_EVERYWHERE:
+            return "joining on each basic block entry";
+
+        case GL_GENERALIZE_CALLS:
+            return "generalizing function calls";
+
+        case GL_GIVE_UP:
+            break;
+    }
+
+    return "giving up";
+}
+
+static bool /* switched */ checkBudget(
+        const struct cl_loc        *loc,
+        const EBudget               bt,
+        const long                  value)
+{
+    Budget &b = budgets[bt];
+    const long limit = GlConf::data.*(b.limit);
+    if (!limit)
+        // the budget is not limited
+        return false;
+
+    if (100L * value <= limit * pctByLevel[govLevel])
+        // the settings we are running with fit the budget
+        return false;
+
+    // switch only one step at a time to let the cheaper settings take effect
+    govLevel = static_cast<EGovLevel>(govLevel + 1);
+    b.hitLevel = govLevel;
+    b.hitValue = value;
+
+    if (GL_GIVE_UP == govLevel) {
+        CL_WARN_MSG(loc, b.name << " budget of " << limit << b.unit
+                << " exhausted, giving up");
+        return true;
+    }
+
+    CL_WARN_MSG(loc, b.name << " budget of " << limit << b.unit
+            << " used to " << value << b.unit
+            << ", switching to " << describeLevel(govLevel));
+    return true;
+}
+
+void ResGovernor::start()
+{
+    govLevel = GL_FULL;
+    startTime = time(0);
+
+    for (int bt = 0; bt < BT_TOTAL; ++bt) {
+        budgets[bt].hitLevel = GL_FULL;
+        budgets[bt].hitValue = 0L;
+    }
+}
+
+EGovLevel ResGovernor::level()
+{
+    return govLevel;
+}
+
+bool /* continue */ ResGovernor::check(
+        const struct cl_loc        *loc,
+        const unsigned              stateSize)
+{
+    if (GL_GIVE_UP == govLevel)
+        // we have already given up
+        return false;
+
+    const GlConf::Options &opts = GlConf::data;
+
+    // the first budget that switches the settings ends the check, so that the
+    // settings change by one step at a time, whatever budgets are exceeded
+    bool switched = false;
+    if (opts.timeLimit)
+        switched = checkBudget(loc, BT_TIME, time(0) - startTime);
+
+    long mib;
+    if (!switched && opts.memLimit && peakRssUsage(&mib))
+        switched = checkBudget(loc, BT_MEM, mib);
+
+    if (!switched && opts.stateLimit)
+        checkBudget(loc, BT_STATE, stateSize);
+
+    return (GL_GIVE_UP != govLevel);
+}
+
+void ResGovernor::printReport()
+{
+    for (int bt = 0; bt < BT_TOTAL; ++bt) {
+        const Budget &b = budgets[bt];
+        if (GL_FULL == b.hitLevel)
+            continue;
+
+        const long limit = GlConf::data.*(b.limit);
+        CL_NOTE(b.name << " budget of " << limit << b.unit
+                << " was hit by " << b.hitValue << b.unit
+                << ", resulting in " << describeLevel(b.hitLevel));
+    }
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef H_GUARD_RESGOV_H
+#define H_GUARD_RESGOV_H
+
+/**
+ * @file resgov.hh
+ * run-time budgets of the analysis, given by the @b time_limit, @b mem_limit
+ * and @b state_limit options.  Once half of a budget is used, the analysis
+ * switches to cheaper settings.  It switches to even cheaper ones at three
+ * quarters of the budget and gives up as soon as the budget is exhausted.
+ */
+
+struct cl_loc;
+
+/// settings of the analysis, ordered from the most precise to the cheapest
+enum EGovLevel {
+    GL_FULL = 0,            ///< the analysis runs as configured in config.h
+    GL_JOIN_EVERYWHERE,     ///< join and abstract on each basic block entry
+    GL_GENERALIZE_CALLS,    ///< also abstract call entries and join results
+    GL_GIVE_UP              ///< the analysis has been terminated
+};
+
+class ResGovernor {
+    public:
+        /// start measuring the time, to be called before the analysis
+        static void start();
+
+        /// the settings of the analysis the budgets allow at the moment
+        static EGovLevel level();
+
+        /**
+         * check the budgets and switch to cheaper settings if needed, by at
+         * most one step per call
+         * @param loc location info used to report the switch
+         * @param stateSize count of heaps in the basic block being entered
+         * @return false once a budget is exhausted, the caller is then
+         * expected to unwind the analysis
+         */
+        static bool check(const struct cl_loc *loc, unsigned stateSize);
+
+        /// print which budgets were hit (if any)
+        static void printReport();
+
+    private:
+        /// library class
+        ResGovernor();
+};
+
+#endif /* H_GUARD_RESGOV_H */
@@ -352,7 +352,7 @@ void dlSegReplaceByConcrete(SymHeap &sh, const TObjId obj)
     // append a trace node for this operation (object IDs preserved 1:1)
     Trace::Node *trOrig = sh.traceNode();
     Trace::Node *trNode = new Trace::ConcretizationNode(trOrig, OK_DLS, pName);
-    trNode->idMapper().setNotFoundAction(Trace::TIdMapper::NFA_RETURN_IDENTITY);
+    trNode->setNotFoundAction(Trace::TIdMapper::NFA_RETURN_IDENTITY);
     sh.traceUpdate(trNode);
 
     // redirect all references originally pointing to obj
@@ -459,7 +459,17 @@ void abstractIfNeeded(SymHeap &sh)
     return;
 #endif
     Shape shape;
-    while (discoverBestAbstraction(&shape, sh)) {
+#if SE_INCREMENTAL_SEG_DISCOVERY
+    SegDiscoveryCache cache;
+    SegDiscoveryCache *const pCache = &cache;
+#else
+    SegDiscoveryCache *const pCache = 0;
+#endif
+    while (discoverBestAbstraction(&shape, sh, pCache)) {
+        if (pCache)
+            // forget what the abstraction is going to change
+            pCache->invalidate(sh, shape);
+
         if (!applyAbstraction(sh, shape))
             // the best abstraction given is unfortunately not good enough
             break;
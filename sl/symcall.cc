@@ -23,6 +23,7 @@
 #include <cl/cl_msg.hh>
 #include <cl/storage.hh>
 
+#include "resgov.hh"
 #include "symabstract.hh"
 #include "symbt.hh"
 #include "symcmp.hh"
@@ -32,6 +33,7 @@
 #include "symjoin.hh"
 #include "symproc.hh"
 #include "symstate.hh"
+#include "symstats.hh"
 #include "symutil.hh"
 #include "symtrace.hh"
 #include "util.hh"
@@ -413,6 +415,15 @@ void SymCallCtx::flushCallResults(SymState &dst)
     CL_BREAK_IF(this != d->cd->ctxStack.back());
     d->cd->ctxStack.pop_back();
 
+    if (!d->computed && GL_GENERALIZE_CALLS <= ResGovernor::level()) {
+        // we are running out of resources, join the results first
+        SymStateWithJoin joined;
+        BOOST_FOREACH(const SymHeap *sh, d->rawResults)
+            joined.insert(*sh);
+
+        d->rawResults.swap(joined);
+    }
+
     // go through the results and make them of the form that the caller likes
     const unsigned cnt = d->rawResults.size();
     for (unsigned i = 0; i < cnt; ++i) {
@@ -716,6 +727,7 @@ SymCallCtx* SymCallCache::Private::getCallCtx(const SymHeap &entry, TFncRef fnc)
     const int uid = uidOf(fnc);
     PerFncCache &pfc = this->cache[uid];
     SymCallCtx *&ctx = pfc.lookup(entry);
+    SymStats::count(SS_CALL_LOOKUPS);
     if (!ctx) {
         // cache miss
         ctx = new SymCallCtx(this);
@@ -746,6 +758,7 @@ SymCallCtx* SymCallCache::Private::getCallCtx(const SymHeap &entry, TFncRef fnc)
 
     // enter ctx stack
     this->ctxStack.push_back(ctx);
+    SymStats::count(SS_CALL_HITS);
 
     // all OK, return the cached ctx
     return ctx;
@@ -798,6 +811,10 @@ SymCallCtx* SymCallCache::getCallCtx(
     callFrame.objInvalidate(OBJ_RETURN);
     entry.traceUpdate(trEntry);
 
+    if (GL_GENERALIZE_CALLS <= ResGovernor::level())
+        // we are running out of resources, improve the chance of cache hit
+        abstractIfNeeded(entry);
+
     LDP_PLOT(symcall, entry);
     LDP_PLOT(symcall, callFrame);
     
@@ -312,7 +312,20 @@ class VarScheduleVisitor {
         }
 };
 
-bool areEqual(
+/// value mapping of areEqual(), recycled among its calls
+struct CmpValMaps {
+    TValMapBidir        vMap;
+
+    void clear() {
+        vMap[0].clear();
+        vMap[1].clear();
+    }
+};
+
+static IdMapRecycler<CmpValMaps> cmpMapsRecycler;
+
+bool areEqualCore(
+        TValMapBidir            &vMap,
         const SymHeap           &sh1,
         const SymHeap           &sh2)
 {
@@ -338,7 +351,6 @@ bool areEqual(
         return false;
 
     // check isomorphism
-    TValMapBidir vMap;
     if (!dfsCmp(wl, vMap, sh1Writable, sh2Writable))
         return false;
 
@@ -346,3 +358,13 @@ bool areEqual(
     return sh1.matchPreds(sh2, vMap[0])
         && sh2.matchPreds(sh1, vMap[1]);
 }
+
+bool areEqual(
+        const SymHeap           &sh1,
+        const SymHeap           &sh2)
+{
+    CmpValMaps *maps = cmpMapsRecycler.alloc();
+    const bool eq = areEqualCore(maps->vMap, sh1, sh2);
+    cmpMapsRecycler.recycle(maps);
+    return eq;
+}
@@ -593,10 +593,26 @@ void digShapePropsCandidates(
 struct SegCandidate {
     TObjId                      entry;
     TShapePropsList             propsList;
+    std::vector<TRankMap>       rankList;   ///< one TRankMap per propsList item
 };
 
 typedef std::vector<SegCandidate> TSegCandidateList;
 
+/// probe neighbouring objects and discover all segments starting at obj
+void discoverSegCandidate(
+        SegCandidate               *pDst,
+        SymHeap                    &sh,
+        const TObjId                obj)
+{
+    pDst->entry = obj;
+    digShapePropsCandidates(&pDst->propsList, sh, obj);
+
+    BOOST_FOREACH(const ShapeProps &props, pDst->propsList) {
+        pDst->rankList.push_back(TRankMap());
+        segDiscover(pDst->rankList.back(), sh, props, obj);
+    }
+}
+
 bool selectBestAbstraction(
         Shape                      *pDst,
         SymHeap                    &sh,
@@ -620,9 +636,10 @@ bool selectBestAbstraction(
 
         // go through binding candidates
         const SegCandidate &segc = candidates[idx];
-        BOOST_FOREACH(const ShapeProps &props, segc.propsList) {
-            TRankMap rMap;
-            segDiscover(rMap, sh, props, segc.entry);
+        const unsigned cntProps = segc.propsList.size();
+        for (unsigned pIdx = 0; pIdx < cntProps; ++pIdx) {
+            const ShapeProps &props = segc.propsList[pIdx];
+            const TRankMap &rMap = segc.rankList[pIdx];
 
             // go through all cost/length pairs
             BOOST_FOREACH(TRankMap::const_reference rank, rMap) {
@@ -634,6 +651,8 @@ bool selectBestAbstraction(
 #if SE_COST_OF_SEG_INTRODUCTION
                 if (!segOnPath(sh, props.bOff, segc.entry, len))
                     cost += (SE_COST_OF_SEG_INTRODUCTION);
+#else
+                (void) sh;
 #endif
 
                 if (len < minLengthByCost(cost))
@@ -669,7 +688,109 @@ bool selectBestAbstraction(
     return true;
 }
 
-bool discoverBestAbstraction(Shape *pDst, SymHeap &sh)
+// /////////////////////////////////////////////////////////////////////////////
+// SegDiscoveryCache implementation
+struct SegDiscoveryCache::Private {
+    typedef std::map<TObjId, SegCandidate>                  TCache;
+
+    TCache                      cache;
+};
+
+SegDiscoveryCache::SegDiscoveryCache():
+    d(new Private)
+{
+}
+
+SegDiscoveryCache::~SegDiscoveryCache()
+{
+    delete d;
+}
+
+/// collect the connected component of the heap graph that obj belongs to
+void collectComponent(TObjSet &dst, SymHeap &sh, const TObjId obj)
+{
+    TObjList todo;
+    if (insertOnce(dst, obj))
+        todo.push_back(obj);
+
+    while (!todo.empty()) {
+        const TObjId now = todo.back();
+        todo.pop_back();
+
+        // objects pointing at/inside now
+        FldList refs;
+        sh.pointedBy(refs, now);
+        BOOST_FOREACH(const FldHandle &fld, refs)
+            if (insertOnce(dst, fld.obj()))
+                todo.push_back(fld.obj());
+
+        // objects pointed by now
+        FldList ptrs;
+        sh.gatherLiveFields(ptrs, now);
+        BOOST_FOREACH(const FldHandle &fld, ptrs) {
+            const TValId val = fld.value();
+            if (val <= 0)
+                continue;
+
+            const TObjId target = sh.objByAddr(val);
+            if (OBJ_INVALID != target && insertOnce(dst, target))
+                todo.push_back(target);
+        }
+    }
+}
+
+void SegDiscoveryCache::invalidate(SymHeap &sh, const Shape &shape)
+{
+    // joinData() can reach objects arbitrarily far from the objects being
+    // joined, so the result of a discovery depends on the whole connected
+    // component of the heap graph its entry belongs to.  Abstraction of the
+    // shape does not reach outside of its component, the results of the
+    // entries in other components thus remain valid.
+    TObjSet touched;
+    collectComponent(touched, sh, shape.entry);
+
+    BOOST_FOREACH(const TObjId obj, touched)
+        d->cache.erase(obj);
+}
+
+#if DEBUG_SEG_DISCOVERY_CACHE
+/// debugging only: compare the cached results with a discovery from scratch
+bool chkCachedCandidates(SymHeap &sh, const TSegCandidateList &candidates)
+{
+    TSegCandidateList fresh;
+    TObjList heapObjs;
+    sh.gatherObjects(heapObjs, isOnHeap);
+    BOOST_FOREACH(const TObjId obj, heapObjs) {
+        SegCandidate segc;
+        discoverSegCandidate(&segc, sh, obj);
+        if (!segc.propsList.empty())
+            fresh.push_back(segc);
+    }
+
+    const unsigned cnt = candidates.size();
+    if (fresh.size() != cnt) {
+        CL_ERROR("SegDiscoveryCache: count of candidates mismatch");
+        return false;
+    }
+
+    for (unsigned idx = 0; idx < cnt; ++idx) {
+        const SegCandidate &cached = candidates[idx];
+        const SegCandidate &now = fresh[idx];
+        if (cached.entry == now.entry
+                && cached.propsList == now.propsList
+                && cached.rankList == now.rankList)
+            continue;
+
+        CL_ERROR("SegDiscoveryCache: stale result for entry #" << now.entry);
+        return false;
+    }
+
+    // all OK
+    return true;
+}
+#endif
+
+bool discoverBestAbstraction(Shape *pDst, SymHeap &sh, SegDiscoveryCache *cache)
 {
     TSegCandidateList candidates;
 
@@ -677,17 +798,32 @@ bool discoverBestAbstraction(Shape *pDst, SymHeap &sh)
     TObjList heapObjs;
     sh.gatherObjects(heapObjs, isOnHeap);
     BOOST_FOREACH(const TObjId obj, heapObjs) {
-        /// probe neighbouring objects
         SegCandidate segc;
-        digShapePropsCandidates(&segc.propsList, sh, obj);
+        if (cache) {
+            SegDiscoveryCache::Private::TCache::const_iterator it =
+                cache->d->cache.find(obj);
+
+            if (cache->d->cache.end() != it)
+                // reuse the results of a previous run
+                segc = it->second;
+            else {
+                discoverSegCandidate(&segc, sh, obj);
+                cache->d->cache[obj] = segc;
+            }
+        }
+        else
+            discoverSegCandidate(&segc, sh, obj);
+
         if (segc.propsList.empty())
             // found nothing
             continue;
 
         // append a segment candidate
-        segc.entry = obj;
         candidates.push_back(segc);
     }
 
+#if DEBUG_SEG_DISCOVERY_CACHE
+    CL_BREAK_IF(cache && !chkCachedCandidates(sh, candidates));
+#endif
     return selectBestAbstraction(pDst, sh, candidates);
 }
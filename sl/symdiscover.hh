@@ -41,11 +41,38 @@ bool canMergeObjWithNextObj(
         const ShapeProps           &props,
         TObjId                     *pNextObj = 0);
 
+class SegDiscoveryCache;
+
 /**
  * Take the given symbolic heap and look for the best possible abstraction in
  * there.  If nothing is found, zero is returned.  Otherwise it returns total
  * length of the best possible abstraction.
+ * @param cache if not null, results of the previous runs are reused from there
  */
-bool discoverBestAbstraction(Shape *pDst, SymHeap &sh);
+bool discoverBestAbstraction(
+        Shape                      *pDst,
+        SymHeap                    &sh,
+        SegDiscoveryCache          *cache = 0);
+
+/// results of discoverBestAbstraction() kept in between abstraction steps
+class SegDiscoveryCache {
+    public:
+        SegDiscoveryCache();
+        ~SegDiscoveryCache();
+
+        /// drop results affected by abstraction of shape (call prior to that)
+        void invalidate(SymHeap &sh, const Shape &shape);
+
+    private:
+        // copying NOT allowed
+        SegDiscoveryCache(const SegDiscoveryCache &);
+        SegDiscoveryCache& operator=(const SegDiscoveryCache &);
+
+        friend bool discoverBestAbstraction(
+                Shape *, SymHeap &, SegDiscoveryCache *);
+
+        struct Private;
+        Private *d;
+};
 
 #endif /* H_GUARD_SYMDISCOVER_H */
@@ -22,6 +22,7 @@
 
 #include "config.h"
 
+#include <algorithm>
 #include <vector>
 
 #include <boost/foreach.hpp>
@@ -160,10 +161,17 @@ struct RefCntLib<RCO_NON_VIRT>: public RefCntLibBase {
 };
 
 
+/**
+ * persistent vector of entities, split into fixed-size chunks
+ *
+ * A copy of EntStore shares whole chunks with the original.  Reference counts
+ * of the entities themselves are bumped lazily, only when a shared chunk is
+ * about to be written and needs to be cloned.
+ */
 template <class TBaseEnt>
 class EntStore {
     public:
-        EntStore() { }
+        EntStore(): size_(0) { }
         inline EntStore(const EntStore &);
         inline ~EntStore();
 
@@ -174,7 +182,7 @@ class EntStore {
 
         template <typename TId> TId lastId() const {
             // we need to be careful with integral arithmetic on enums
-            const long last = -1L + ents_.size();
+            const long last = -1L + size_;
             return static_cast<TId>(last);
         }
 
@@ -195,18 +203,74 @@ class EntStore {
         // intentionally not implemented
         EntStore& operator=(const EntStore &);
 
-        std::vector<TBaseEnt *>                 ents_;
+        enum {
+            CHUNK_BITS = 6,
+            CHUNK_SIZE = 1 << CHUNK_BITS,
+            CHUNK_MASK = CHUNK_SIZE - 1
+        };
+
+        struct Chunk {
+            RefCounter                          refCnt;
+            TBaseEnt                           *ents[CHUNK_SIZE];
+
+            Chunk() {
+                std::fill(ents, ents + CHUNK_SIZE, static_cast<TBaseEnt *>(0));
+            }
+
+            /// the entities are now shared by both the chunks
+            Chunk(const Chunk &ref) {
+                std::copy(ref.ents, ref.ents + CHUNK_SIZE, ents);
+                BOOST_FOREACH(TBaseEnt *&ent, ents)
+                    if (ent)
+                        RefCntLib<RCO_VIRTUAL>::enter(ent);
+            }
+
+            ~Chunk() {
+                BOOST_FOREACH(TBaseEnt *ent, ents)
+                    if (ent)
+                        RefCntLib<RCO_VIRTUAL>::leave(ent);
+            }
+
+            private:
+                // intentionally not implemented
+                Chunk& operator=(const Chunk &);
+        };
+
+        inline TBaseEnt* slotRO(const long id) const;
+        inline TBaseEnt*& slotRW(const long id);
+
+        std::vector<Chunk *>                    chunks_;
+        long                                    size_;
 };
 
 
 // /////////////////////////////////////////////////////////////////////////////
 // implementation of EntStore
+template <class TBaseEnt>
+TBaseEnt* EntStore<TBaseEnt>::slotRO(const long id) const
+{
+    return chunks_[id >> CHUNK_BITS]->ents[id & CHUNK_MASK];
+}
+
+template <class TBaseEnt>
+TBaseEnt*& EntStore<TBaseEnt>::slotRW(const long id)
+{
+    const unsigned idx = id >> CHUNK_BITS;
+    while (chunks_.size() <= idx)
+        chunks_.push_back(new Chunk);
+
+    // clone the chunk if it is shared with another EntStore
+    Chunk *&chunk = chunks_[idx];
+    RefCntLib<RCO_NON_VIRT>::requireExclusivity(chunk);
+    return chunk->ents[id & CHUNK_MASK];
+}
+
 template <class TBaseEnt>
 template <typename TId>
 TId EntStore<TBaseEnt>::assignId(TBaseEnt *ptr)
 {
     CL_BREAK_IF(ptr->refCnt.isShared());
-    this->ents_.push_back(ptr);
+    this->slotRW(size_++) = ptr;
     return this->lastId<TId>();
 }
 
@@ -218,9 +282,9 @@ void EntStore<TBaseEnt>::assignId(const TId id, TBaseEnt *ptr)
 
     // make sure we have enough space allocated
     if (this->lastId<TId>() < id)
-        ents_.resize(id + 1, 0);
+        size_ = id + 1L;
 
-    TBaseEnt *&ref = ents_[id];
+    TBaseEnt *&ref = this->slotRW(id);
 
     // if this fails, you wanted to overwrite pointer to a valid entity
     CL_BREAK_IF(ref);
@@ -232,7 +296,7 @@ template <class TBaseEnt>
 template <typename TId>
 void EntStore<TBaseEnt>::releaseEnt(const TId id)
 {
-    RefCntLib<RCO_VIRTUAL>::leave(ents_[id]);
+    RefCntLib<RCO_VIRTUAL>::leave(this->slotRW(id));
 }
 
 template <class TBaseEnt>
@@ -242,24 +306,23 @@ bool EntStore<TBaseEnt>::isValidEnt(const TId id) const
     if (this->outOfRange(id))
         return false;
 
-    return !!ents_[id];
+    return !!this->slotRO(id);
 }
 
 template <class TBaseEnt>
 EntStore<TBaseEnt>::EntStore(const EntStore &ref):
-    ents_(ref.ents_)
+    chunks_(ref.chunks_),
+    size_(ref.size_)
 {
-    BOOST_FOREACH(TBaseEnt *&ent, ents_)
-        if (ent)
-            RefCntLib<RCO_VIRTUAL>::enter(ent);
+    BOOST_FOREACH(Chunk *&chunk, chunks_)
+        RefCntLib<RCO_NON_VIRT>::enter(chunk);
 }
 
 template <class TBaseEnt>
 EntStore<TBaseEnt>::~EntStore()
 {
-    BOOST_FOREACH(TBaseEnt *ent, ents_)
-        if (ent)
-            RefCntLib<RCO_VIRTUAL>::leave(ent);
+    BOOST_FOREACH(Chunk *chunk, chunks_)
+        RefCntLib<RCO_NON_VIRT>::leave(chunk);
 }
 
 template <class TBaseEnt>
@@ -270,7 +333,7 @@ inline const TBaseEnt* EntStore<TBaseEnt>::getEntRO(const TId id)
     CL_BREAK_IF(this->outOfRange(id));
 
     // if this fails, the ID is no longer valid
-    const TBaseEnt *ptr = ents_[id];
+    const TBaseEnt *ptr = this->slotRO(id);
     CL_BREAK_IF(!ptr);
     return ptr;
 }
@@ -282,7 +345,7 @@ inline TBaseEnt* EntStore<TBaseEnt>::getEntRW(const TId id)
 #ifndef NDEBUG
     this->getEntRO(id);
 #endif
-    TBaseEnt *&entRW = ents_[id];
+    TBaseEnt *&entRW = this->slotRW(id);
     RefCntLib<RCO_VIRTUAL>::requireExclusivity(entRW);
     return entRW;
 }
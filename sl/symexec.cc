@@ -28,12 +28,14 @@
 
 #include "fixed_point_proxy.hh"
 #include "glconf.hh"
+#include "resgov.hh"
 #include "sigcatch.hh"
 #include "symabstract.hh"
 #include "symcall.hh"
 #include "symdebug.hh"
 #include "symproc.hh"
 #include "symstate.hh"
+#include "symstats.hh"
 #include "symutil.hh"
 #include "symtrace.hh"
 #include "util.hh"
@@ -60,9 +62,10 @@ bool installSignalHandlers(void)
 class SymExecEngine;
 
 struct ExecStackItem {
-    SymCallCtx      *ctx;
-    SymExecEngine   *eng;
-    SymState        *dst;
+    SymCallCtx              *ctx;
+    SymExecEngine           *eng;
+    SymState                *dst;
+    const CodeStorage::Fnc  *fnc;
 };
 
 typedef std::deque<ExecStackItem> TExecStack;
@@ -85,7 +88,10 @@ class SymExec: public IStatsProvider {
                 SymHeap                     entry,
                 const CodeStorage::Insn     &insn);
 
-        void enterCall(SymCallCtx *ctx, SymState &results);
+        void enterCall(
+                SymCallCtx                      *ctx,
+                const CodeStorage::Fnc          &fnc,
+                SymState                        &results);
 
         void execFnc(
                 SymState                    &results,
@@ -96,6 +102,9 @@ class SymExec: public IStatsProvider {
         virtual void printStats() const;
 
     private:
+        void leaveCall();
+        void unwindStack();
+
         const CodeStorage::Storage              &stor_;
         SymCallCache                            callCache_;
         TExecStack                              execStack_;
@@ -277,6 +286,7 @@ void SymExecEngine::execReturn()
     // commit one of the function results
     dst_.insert(sh);
     endReached_ = true;
+    SymStats::count(SS_PATHS);
 }
 
 bool isLoopClosingEdge(
@@ -298,15 +308,20 @@ void SymExecEngine::updateState(SymHeap &sh, const CodeStorage::Block *ofBlock)
     if (closingLoop)
         CL_DEBUG_MSG(lw_, "-L- traversing a loop-closing edge");
 
+    // join and abstract everywhere if we are running out of resources
+    const bool joinAll = (GL_JOIN_EVERYWHERE <= ResGovernor::level());
+
     // time to consider abstraction
 #if SE_ABSTRACT_ON_LOOP_EDGES_ONLY
-    if (closingLoop)
+    if (closingLoop || joinAll)
 #endif
         abstractIfNeeded(sh);
 
 #if !SE_JOIN_ON_LOOP_EDGES_ONLY
     closingLoop = true;
 #endif
+    if (joinAll)
+        closingLoop = true;
 
     // update _target_ state and check if anything has changed
     if (stateMap_.insert(ofBlock, sh, closingLoop)) {
@@ -638,6 +653,7 @@ bool /* complete */ SymExecEngine::execInsn()
 
             // mark as processed now since it can be re-scheduled right away
             origin.setDone(heapIdx_);
+            SymStats::count(SS_HEAPS);
         }
 
         // capture fixed-point for plotting if configured to do so
@@ -698,6 +714,13 @@ bool /* complete */ SymExecEngine::execBlock()
         const SymState &origin = stateMap_[block_];
         localState_ = origin;
 
+        // switch to cheaper settings (or give up) if a budget is exceeded
+        if (!ResGovernor::check(lw_, origin.size()))
+            // SymExec is going to unwind the exec stack
+            return false;
+
+        SymStats::count(SS_BLOCKS);
+
         // eliminate the unneeded Trace::CloneNode instances
         Trace::waiveCloneOperation(localState_);
     }
@@ -1131,7 +1154,10 @@ fail:
     return 0;
 }
 
-void SymExec::enterCall(SymCallCtx *ctx, SymState &results)
+void SymExec::enterCall(
+        SymCallCtx                      *ctx,
+        const CodeStorage::Fnc          &fnc,
+        SymState                        &results)
 {
     // create engine
     SymExecEngine *eng = new SymExecEngine(
@@ -1145,12 +1171,42 @@ void SymExec::enterCall(SymCallCtx *ctx, SymState &results)
     item.ctx = ctx;
     item.eng = eng;
     item.dst = &results;
+    item.fnc = &fnc;
 
     // push the item to the exec-stack
     execStack_.push_front(item);
+
+    if (GlConf::data.fixedPoint)
+        GlConf::data.fixedPoint->enterFnc(&fnc);
+
     printMemUsage("SymExec::enterCall");
 }
 
+void SymExec::leaveCall()
+{
+    const ExecStackItem &item = execStack_.front();
+    const CodeStorage::Fnc *fnc = item.fnc;
+
+    // remove top of the stack
+    delete item.eng;
+    printMemUsage("SymExecEngine::~SymExecEngine");
+    execStack_.pop_front();
+
+    if (GlConf::data.fixedPoint)
+        // plot fixed-points of functions that cannot be called again
+        GlConf::data.fixedPoint->leaveFnc(fnc);
+}
+
+void SymExec::unwindStack()
+{
+    // NOTE this is actually the right direction (from top of the backtrace)
+    while (!execStack_.empty()) {
+        // the results of the call are incomplete, do not keep them cached
+        execStack_.front().ctx->invalidate();
+        this->leaveCall();
+    }
+}
+
 void SymExec::execFnc(
         SymState                        &results,
         const SymHeap                   &entry,
@@ -1162,7 +1218,7 @@ void SymExec::execFnc(
     CL_BREAK_IF(!ctx || !ctx->needExec());
 
     // root call
-    this->enterCall(ctx, results);
+    this->enterCall(ctx, fnc, results);
 
     // main loop
     while (!execStack_.empty()) {
@@ -1182,9 +1238,7 @@ void SymExec::execFnc(
                                       && engine->endReached();
 
             // remove top of the stack
-            delete engine;
-            printMemUsage("SymExecEngine::~SymExecEngine");
-            execStack_.pop_front();
+            this->leaveCall();
 
             if (!execStack_.empty() && forceEndReached)
                 // well, we got no results, but the callee suggests to be silent
@@ -1194,6 +1248,14 @@ void SymExec::execFnc(
             continue;
         }
 
+        if (GL_GIVE_UP == ResGovernor::level()) {
+            // a budget has been exhausted, leave all the calls we are in
+            this->unwindStack();
+            CL_WARN_MSG(locationOf(fnc),
+                    "symbolic execution terminates prematurely");
+            return;
+        }
+
         // function call requested
         // --> we need to nest unless the computed result is already available
         SymState &dst = engine->callResults();
@@ -1227,7 +1289,7 @@ void SymExec::execFnc(
         }
 
         // create a new engine and push it to the exec stack
-        this->enterCall(ctx, dst);
+        this->enterCall(ctx, *fnc, dst);
     }
 }
 
@@ -28,6 +28,7 @@
 #include "symutil.hh"
 #include "worklist.hh"
 
+#include <map>
 #include <stack>
 
 #include <boost/foreach.hpp>
@@ -49,33 +50,121 @@ void gatherReferredRoots(TObjSet &dst, SymHeap &sh, TObjId obj)
     }
 }
 
-bool isJunk(SymHeap &sh, TObjId obj)
+/**
+ * answers whether an object is junk, remembering the answers for all objects
+ * visited on the way
+ *
+ * An object is junk iff no non-heap object can reach it.  SymHeapCore counts
+ * the fields of non-heap objects pointing into each object, so most objects
+ * are decided locally:  an object pointed by a non-heap object is not junk and
+ * an object pointed by nothing at all is junk.  The objects pointed only by
+ * heap objects, which is the case of cycles and shared subgraphs, are decided
+ * by a backward walk over their heap referrers, which stops as soon as it
+ * reaches an object pointed by a non-heap object.
+ *
+ * Destroying a junk object cannot change the answer for any other object
+ * because no path from a non-heap object goes through a junk object.  The
+ * answers thus remain valid as long as only junk objects are being destroyed
+ * in between.
+ */
+class JunkOracle {
+    public:
+        JunkOracle(SymHeap &sh):
+            sh_(sh)
+        {
+        }
+
+        bool isJunk(TObjId obj);
+
+    private:
+        typedef std::map<TObjId, TObjId>            TParentMap;
+
+        bool isRootedLocally(TObjId obj) const;
+        bool isJunkCycle(TObjId obj);
+
+        SymHeap                    &sh_;
+        TObjSet                     junk_;
+        TObjSet                     rooted_;
+};
+
+bool JunkOracle::isRootedLocally(const TObjId obj) const
+{
+    const EStorageClass code = sh_.objStorClass(obj);
+    if (!isOnHeap(code))
+        // non-heap objects cannot be JUNK
+        return true;
+
+    // neither can the objects they point to
+    return (0 < sh_.pointedByRootCount(obj));
+}
+
+bool JunkOracle::isJunk(const TObjId obj)
 {
-    if (!sh.isValid(obj))
+    if (!sh_.isValid(obj))
         // this object is already freed
         return false;
 
+    if (this->isRootedLocally(obj))
+        return false;
+
+    if (!sh_.pointedByCount(obj))
+        // nothing points to this object
+        return true;
+
+    if (hasKey(rooted_, obj))
+        return false;
+
+    if (hasKey(junk_, obj))
+        return true;
+
+    return this->isJunkCycle(obj);
+}
+
+bool JunkOracle::isJunkCycle(const TObjId obj)
+{
     WorkList<TObjId> wl(obj);
+    TParentMap parentOf;
+    TObjList visited;
 
-    while (wl.next(obj)) {
-        CL_BREAK_IF(!sh.isValid(obj));
+    TObjId cur;
+    while (wl.next(cur)) {
+        CL_BREAK_IF(!sh_.isValid(cur));
+        visited.push_back(cur);
+
+        if (hasKey(rooted_, cur) || this->isRootedLocally(cur)) {
+            // a non-heap object reaches this object, thus also the objects
+            // it reaches, remember the path we came through
+            for (TObjId on = cur; rooted_.insert(on), obj != on;)
+                on = parentOf[on];
 
-        const EStorageClass code = sh.objStorClass(obj);
-        if (!isOnHeap(code))
-            // non-heap objects cannot be JUNK
             return false;
+        }
 
-        // go through all referrers
+        if (hasKey(junk_, cur))
+            // all referrers of a junk object are junk objects
+            continue;
+
+        // go through all referrers, all of them are on heap
         FldList refs;
-        sh.pointedBy(refs, obj);
-        BOOST_FOREACH(const FldHandle &fld, refs)
-            wl.schedule(fld.obj());
+        sh_.pointedBy(refs, cur);
+        BOOST_FOREACH(const FldHandle &fld, refs) {
+            const TObjId ref = fld.obj();
+            if (wl.schedule(ref))
+                parentOf[ref] = cur;
+        }
     }
 
+    // nothing we have visited is reachable from a non-heap object
+    junk_.insert(visited.begin(), visited.end());
     return true;
 }
 
-bool gcCore(SymHeap &sh, TObjId obj, TObjSet *leakObjs, bool sharedOnly)
+bool gcCore(
+        SymHeap                 &sh,
+        TObjId                   obj,
+        TObjSet                 *leakObjs,
+        bool                     sharedOnly,
+        JunkOracle              &oracle)
 {
     if (OBJ_INVALID == obj)
         return false;
@@ -88,7 +177,7 @@ bool gcCore(SymHeap &sh, TObjId obj, TObjSet *leakObjs, bool sharedOnly)
 
     WorkList<TObjId> wl(obj);
     while (wl.next(obj)) {
-        if (!isJunk(sh, obj))
+        if (!oracle.isJunk(obj))
             // not a junk, keep going...
             continue;
 
@@ -121,12 +210,28 @@ skip_root:
 
 bool collectJunk(SymHeap &sh, TObjId obj, TObjSet *leakObjs)
 {
-    return gcCore(sh, obj, leakObjs, /* sharedOnly */ false);
+    JunkOracle oracle(sh);
+    return gcCore(sh, obj, leakObjs, /* sharedOnly */ false, oracle);
 }
 
 bool collectSharedJunk(SymHeap &sh, TObjId obj, TObjSet *leakObjs)
 {
-    return gcCore(sh, obj, leakObjs, /* sharedOnly */ true);
+    JunkOracle oracle(sh);
+    return gcCore(sh, obj, leakObjs, /* sharedOnly */ true, oracle);
+}
+
+bool collectJunkFromEach(SymHeap &sh, const TObjList &objs, TObjSet *leakObjs)
+{
+    // only junk objects are destroyed meanwhile, so we can share the oracle
+    JunkOracle oracle(sh);
+
+    bool leaking = false;
+    BOOST_FOREACH(const TObjId obj, objs) {
+        if (gcCore(sh, obj, leakObjs, /* sharedOnly */ false, oracle))
+            leaking = true;
+    }
+
+    return leaking;
 }
 
 bool destroyObjectAndCollectJunk(
@@ -144,13 +249,8 @@ bool destroyObjectAndCollectJunk(
     sh.objInvalidate(obj);
 
     // now check for memory leakage
-    bool leaking = false;
-    BOOST_FOREACH(const TObjId obj, refs) {
-        if (collectJunk(sh, obj, leakObjs))
-            leaking = true;
-    }
-
-    return leaking;
+    const TObjList objs(refs.begin(), refs.end());
+    return collectJunkFromEach(sh, objs, leakObjs);
 }
 
 // /////////////////////////////////////////////////////////////////////////////
@@ -42,6 +42,15 @@ bool /* found */ collectJunk(SymHeap &sh, TObjId obj, TObjSet *leakObjs = 0);
 /// same as collectJunk(), but does not consider prototypes to be junk objects
 bool collectSharedJunk(SymHeap &sh, TObjId obj, TObjSet *leakObjs = 0);
 
+/**
+ * same as calling collectJunk() for each of the given objects in turn, but the
+ * results of reachability analysis are shared among the calls
+ */
+bool collectJunkFromEach(
+        SymHeap                 &sh,
+        const TObjList          &objs,
+        TObjSet                 *leakObjs = 0);
+
 bool destroyObjectAndCollectJunk(
         SymHeap                 &sh,
         const TObjId             obj,
@@ -61,14 +70,11 @@ class LeakMonitor {
 
         template <class TCont>
         bool collectJunkFrom(const TCont &killedPtrs) {
-            bool leaking = false;
-            BOOST_FOREACH(TValId val, killedPtrs) {
-                const TObjId obj = sh_.objByAddr(val);
-                if (collectJunk(sh_, obj, &leakObjs_))
-                    leaking = true;
-            }
-
-            return leaking;
+            TObjList objs;
+            BOOST_FOREACH(TValId val, killedPtrs)
+                objs.push_back(sh_.objByAddr(val));
+
+            return collectJunkFromEach(sh_, objs, &leakObjs_);
         }
 
         bool /* leaking */ destroyObject(const TObjId obj) {
@@ -338,10 +338,83 @@ inline EBlockKind bkFromClt(const TObjType clt)
         : BK_FIELD;
 }
 
+#if SH_ENT_POOL
+/// slab allocator of heap entities, one free list per size class
+class EntPool {
+    public:
+        static void* alloc(const size_t size) {
+            const unsigned cl = sizeClass(size);
+            if (N_CLASSES <= cl)
+                // too big to be pooled
+                return ::operator new(size);
+
+            FreeItem *&head = freeList_[cl];
+            if (!head)
+                refill(&head, /* item size */ GRAIN * (cl + 1U));
+
+            FreeItem *item = head;
+            head = item->next;
+            return item;
+        }
+
+        static void release(void *ptr, const size_t size) {
+            const unsigned cl = sizeClass(size);
+            if (N_CLASSES <= cl) {
+                ::operator delete(ptr);
+                return;
+            }
+
+            FreeItem *item = static_cast<FreeItem *>(ptr);
+            item->next = freeList_[cl];
+            freeList_[cl] = item;
+        }
+
+    private:
+        enum {
+            GRAIN       = 0x10,
+            N_CLASSES   = 0x20,
+            SLAB_SIZE   = 0x10000
+        };
+
+        struct FreeItem {
+            FreeItem *next;
+        };
+
+        static FreeItem *freeList_[N_CLASSES];
+
+        static unsigned sizeClass(const size_t size) {
+            return (size - 1U) / GRAIN;
+        }
+
+        /// the slabs are intentionally never released, they are reused
+        static void refill(FreeItem **pHead, const size_t itemSize) {
+            char *slab = static_cast<char *>(::operator new(SLAB_SIZE));
+            for (size_t off = 0U; off + itemSize <= SLAB_SIZE; off += itemSize) {
+                FreeItem *item = reinterpret_cast<FreeItem *>(slab + off);
+                item->next = *pHead;
+                *pHead = item;
+            }
+        }
+};
+
+EntPool::FreeItem *EntPool::freeList_[EntPool::N_CLASSES];
+#endif
+
 class AbstractHeapEntity {
     public:
         virtual AbstractHeapEntity* clone() const = 0;
 
+#if SH_ENT_POOL
+        static void* operator new(size_t size) {
+            return EntPool::alloc(size);
+        }
+
+        /// the size is taken from the dynamic type thanks to virtual destructor
+        static void operator delete(void *ptr, size_t size) {
+            EntPool::release(ptr, size);
+        }
+#endif
+
     protected:
         virtual ~AbstractHeapEntity() { }
         friend class EntStore<AbstractHeapEntity>;
@@ -488,6 +561,7 @@ struct Region: public AbstractHeapEntity {
     TSizeRange                      size;
     TLiveObjs                       liveFields;
     TFldIdSet                       usedByGl;
+    unsigned                        usedByRootCnt;
     TArena                          arena;
     TObjType                        lastKnownClt;
     bool                            isValid;
@@ -497,6 +571,7 @@ struct Region: public AbstractHeapEntity {
     Region(EStorageClass code_):
         code(code_),
         size(IR::rngFromNum(0)),
+        usedByRootCnt(0),
         lastKnownClt(0),
         isValid(true),
         protoLevel(/* not a prototype */ 0)
@@ -620,6 +695,7 @@ struct SymHeapCore::Private {
             const TOffset           shift = 0,
             const TSizeOf           sizeLimit = 0);
 
+    bool isRootField(TFldId fld);
     bool /* wasPtr */ releaseValueOf(TFldId fld, TValId val);
     void registerValueOf(TFldId fld, TValId val);
     void splitBlockByObject(TFldId block, TFldId fld);
@@ -631,6 +707,9 @@ struct SymHeapCore::Private {
     // runs only in debug build
     bool chkValueDeps(const TValId);
 
+    // runs only in debug build
+    bool chkUsedByRootCnt(const Region *regData);
+
     // runs only in debug build
     bool chkArenaConsistency(
             const Region           *rootData,
@@ -704,6 +783,17 @@ inline TObjId SymHeapCore::Private::assignId(Region *regData)
     return this->ents.assignId<TObjId>(regData);
 }
 
+/// true if the given field is owned by a non-heap object
+bool SymHeapCore::Private::isRootField(TFldId fld)
+{
+    const FieldOfObj *fldData;
+    this->ents.getEntRO(&fldData, fld);
+
+    const Region *ownerData;
+    this->ents.getEntRO(&ownerData, fldData->obj);
+    return !isOnHeap(ownerData->code);
+}
+
 bool /* wasPtr */ SymHeapCore::Private::releaseValueOf(TFldId fld, TValId val)
 {
     if (val <= 0)
@@ -741,6 +831,8 @@ bool /* wasPtr */ SymHeapCore::Private::releaseValueOf(TFldId fld, TValId val)
 
     if (1 != regData->usedByGl.erase(fld))
         CL_BREAK_IF("SymHeapCore::Private::releaseValueOf(): offset detected");
+    else if (this->isRootField(fld))
+        --regData->usedByRootCnt;
 
     return /* wasPtr */ true;
 }
@@ -767,7 +859,19 @@ void SymHeapCore::Private::registerValueOf(TFldId fld, TValId val)
     // update usedByGl
     Region *regData;
     this->ents.getEntRW(&regData, rootData->obj);
-    regData->usedByGl.insert(fld);
+    if (regData->usedByGl.insert(fld).second && this->isRootField(fld))
+        ++regData->usedByRootCnt;
+}
+
+// runs only in debug build
+bool SymHeapCore::Private::chkUsedByRootCnt(const Region *regData)
+{
+    unsigned cnt = 0;
+    BOOST_FOREACH(const TFldId fld, regData->usedByGl)
+        if (this->isRootField(fld))
+            ++cnt;
+
+    return (cnt == regData->usedByRootCnt);
 }
 
 // runs only in debug build
@@ -1639,6 +1743,14 @@ unsigned SymHeapCore::pointedByCount(TObjId obj) const
     return regData->usedByGl.size();
 }
 
+unsigned SymHeapCore::pointedByRootCount(TObjId obj) const
+{
+    const Region *regData;
+    d->ents.getEntRO(&regData, obj);
+    CL_BREAK_IF(!d->chkUsedByRootCnt(regData));
+    return regData->usedByRootCnt;
+}
+
 unsigned SymHeapCore::lastId() const
 {
     return d->ents.lastId<unsigned>();
@@ -2652,11 +2764,18 @@ void SymHeapCore::rewriteTargetOfBase(TValId root, TObjId objNew)
         // resolve base address
         const BaseValue *valData;
         d->ents.getEntRO(&valData, val);
-        if (valData->valRoot == root)
-            // reference moved
-            regDataNew->usedByGl.insert(fld);
-        else
+        if (valData->valRoot != root) {
             unrelatedFlds.insert(fld);
+            continue;
+        }
+
+        // reference moved
+        const bool isNew = regDataNew->usedByGl.insert(fld).second;
+        if (d->isRootField(fld)) {
+            --regDataOld->usedByRootCnt;
+            if (isNew)
+                ++regDataNew->usedByRootCnt;
+        }
     }
 
     // write unmoved field IDs
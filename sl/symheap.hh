@@ -28,13 +28,14 @@
 
 #include "config.h"
 
+#include "id_map.hh"
 #include "intrange.hh"
 #include "symid.hh"
 #include "util.hh"
 
 #include <cl/code_listener.h>
 
-#include <map>              // for TValMap
+#include <map>
 #include <set>              // for TCVarSet
 #include <string>
 #include <vector>           // for many types
@@ -216,10 +217,10 @@ typedef std::set<TValId>                                TValSet;
 typedef std::set<TObjId>                                TObjSet;
 
 /// a type used for (injective) value IDs mapping
-typedef std::map<TValId, TValId>                        TValMap;
+typedef IdMap<TValId, TValId>                           TValMap;
 
 /// a type used for (injective) object IDs mapping
-typedef std::map<TObjId, TObjId>                        TObjMap;
+typedef IdMap<TObjId, TObjId>                           TObjMap;
 
 /// a type used for type-info
 typedef const struct cl_type                           *TObjType;
@@ -385,6 +386,9 @@ class SymHeapCore {
         /// return how many objects point at/inside the given object
         unsigned pointedByCount(TObjId) const;
 
+        /// return how many fields of non-heap objects point at/inside the obj
+        unsigned pointedByRootCount(TObjId) const;
+
         /// write an uninitialized or nullified block of memory
         void writeUniformBlock(
                 const TObjId                obj,
@@ -116,7 +116,31 @@ typedef WorkList<SchedItem>                                     TWorkList;
 
 typedef TObjMap                                                 TObjMapBidir[2];
 
-typedef std::map<TValPair /* (v1, v2) */, TValId /* dst */>     TJoinCache;
+typedef IdPairMap<TValId /* (v1, v2) */, TValId /* dst */>      TJoinCache;
+
+/// lookup tables of SymJoinCtx, recycled among the calls of join*()
+struct SymJoinMaps {
+    TValMapBidir                valMap1;
+    TValMapBidir                valMap2;
+
+    TObjMapBidir                objMap1;
+    TObjMapBidir                objMap2;
+
+    TJoinCache                  joinCache;
+
+    void clear() {
+        for (int i = 0; i < 2; ++i) {
+            valMap1[i].clear();
+            valMap2[i].clear();
+            objMap1[i].clear();
+            objMap2[i].clear();
+        }
+
+        joinCache.clear();
+    }
+};
+
+static IdMapRecycler<SymJoinMaps> joinMapsRecycler;
 
 /// current state, common for joinSymHeaps() and joinData()
 struct SymJoinCtx {
@@ -127,11 +151,13 @@ struct SymJoinCtx {
     const TProtoLevel           l1Drift;
     const TProtoLevel           l2Drift;
 
-    TValMapBidir                valMap1;
-    TValMapBidir                valMap2;
+    SymJoinMaps                *const maps;
 
-    TObjMapBidir                objMap1;
-    TObjMapBidir                objMap2;
+    TValMapBidir               &valMap1;
+    TValMapBidir               &valMap2;
+
+    TObjMapBidir               &objMap1;
+    TObjMapBidir               &objMap2;
 
     TWorkList                   wl;
     EJoinStatus                 status;
@@ -140,7 +166,7 @@ struct SymJoinCtx {
 
     std::set<TObjId /* dst */>  protos;
 
-    TJoinCache                  joinCache;
+    TJoinCache                 &joinCache;
 
     void initValMaps() {
         // VAL_NULL should be always mapped to VAL_NULL
@@ -166,9 +192,15 @@ struct SymJoinCtx {
         sh2(sh2_),
         l1Drift(0),
         l2Drift(0),
+        maps(joinMapsRecycler.alloc()),
+        valMap1(maps->valMap1),
+        valMap2(maps->valMap2),
+        objMap1(maps->objMap1),
+        objMap2(maps->objMap2),
         status(JS_USE_ANY),
         forceThreeWay(false),
-        allowThreeWay((1 < (SE_ALLOW_THREE_WAY_JOIN)) && allowThreeWay_)
+        allowThreeWay((1 < (SE_ALLOW_THREE_WAY_JOIN)) && allowThreeWay_),
+        joinCache(maps->joinCache)
     {
         initValMaps();
     }
@@ -180,13 +212,23 @@ struct SymJoinCtx {
         sh2(sh_),
         l1Drift(l1Drift_),
         l2Drift(l2Drift_),
+        maps(joinMapsRecycler.alloc()),
+        valMap1(maps->valMap1),
+        valMap2(maps->valMap2),
+        objMap1(maps->objMap1),
+        objMap2(maps->objMap2),
         status(JS_USE_ANY),
         forceThreeWay(false),
-        allowThreeWay(0 < (SE_ALLOW_THREE_WAY_JOIN))
+        allowThreeWay(0 < (SE_ALLOW_THREE_WAY_JOIN)),
+        joinCache(maps->joinCache)
     {
         initValMaps();
     }
 
+    ~SymJoinCtx() {
+        joinMapsRecycler.recycle(maps);
+    }
+
     bool joiningData() const {
         return (&dst == &sh1)
             && (&dst == &sh2);
@@ -22,6 +22,7 @@
 
 #include <cl/cl_msg.hh>
 #include <cl/clutil.hh>
+#include <cl/plotwriter.hh>
 #include <cl/storage.hh>
 
 #include "plotenum.hh"
@@ -32,7 +33,6 @@
 #include "worklist.hh"
 
 #include <cctype>
-#include <fstream>
 #include <iomanip>
 #include <map>
 #include <set>
@@ -130,7 +130,7 @@ struct PlotData {
     typedef std::vector<TDangVal>                           TDangValues;
 
     SymHeap                            &sh;
-    std::ostream                       &out;
+    PlotRecord                         &out;
     const TObjSet                      &objs;
     const TValSet                      &values;
     const TIdSet                       *pHighlight;
@@ -141,7 +141,7 @@ struct PlotData {
 
     PlotData(
             const SymHeap              &sh_,
-            std::ostream               &out_,
+            PlotRecord                 &out_,
             const TObjSet              &objs_,
             const TValSet              &values_,
             const TIdSet               *pHighlight_):
@@ -351,7 +351,7 @@ void describeField(PlotData &plot, const FldHandle &fld, const bool lonely)
 }
 
 void printRawInt(
-        std::ostream                &str,
+        PlotRecord                  &str,
         const IR::TInt               i,
         const char                  *suffix = "")
 {
@@ -366,7 +366,7 @@ void printRawInt(
 }
 
 void printRawRange(
-        std::ostream                &str,
+        PlotRecord                  &str,
         const IR::Range             &rng,
         const char                  *suffix = "")
 {
@@ -603,9 +603,12 @@ void plotFields(PlotData &plot, const TObjId obj, const TCont &liveFields)
     }
 }
 
-std::string labelOfCompObj(const SymHeap &sh, const TObjId obj, bool showProps)
+void describeCompObj(
+        PlotRecord                     &label,
+        const SymHeap                  &sh,
+        const TObjId                    obj,
+        const bool                      showProps)
 {
-    std::ostringstream label;
     const TProtoLevel protoLevel= sh.objProtoLevel(obj);
     if (protoLevel)
         label << "[L" << protoLevel << " prototype] ";
@@ -613,7 +616,7 @@ std::string labelOfCompObj(const SymHeap &sh, const TObjId obj, bool showProps)
     const EObjKind kind = sh.objKind(obj);
     switch (kind) {
         case OK_REGION:
-            return label.str();
+            return;
 
         case OK_OBJ_OR_NULL:
         case OK_SEE_THROUGH:
@@ -664,8 +667,6 @@ std::string labelOfCompObj(const SymHeap &sh, const TObjId obj, bool showProps)
         if (OK_DLS == kind)
             label << ", prev [" << SIGNED_OFF(bf.prev) << "]";
     }
-
-    return label.str();
 }
 
 template <class TCont>
@@ -719,13 +720,15 @@ void plotCompositeObj(PlotData &plot, const TObjId obj, const TCont &liveFields)
         ? "azure2"
         : "white";
 
-    const std::string label = labelOfCompObj(sh, obj, /* showProps */ true);
-
     // open cluster
     plot.out
         << "subgraph \"cluster" << (++plot.last)
-        << "\" {\n\trank=same;\n\tlabel=" << SL_QUOTE(label)
-        << ";\n\tcolor=" << color
+        << "\" {\n\trank=same;\n\tlabel=\"";
+
+    describeCompObj(plot.out, sh, obj, /* showProps */ true);
+
+    plot.out
+        << "\";\n\tcolor=" << color
         << ";\n\tfontcolor=" << color
         << ";\n\tbgcolor=" << bgColor
         << ";\n\tpenwidth=" << pw
@@ -1179,7 +1182,7 @@ void plotNeqCustom(PlotData &plot, const TValId val, const TValId valCustom)
         ", penwidth=2.0];\n";
 }
 
-void plotNeq(std::ostream &out, const TValId v1, const TValId v2)
+void plotNeq(PlotRecord &out, const TValId v1, const TValId v2)
 {
     out << "\t" << SL_QUOTE(v1)
         << " -> " << SL_QUOTE(v2)
@@ -1276,40 +1279,34 @@ bool plotHeapCore(
         *pName = plotName;
 
     // create a dot file
-    std::fstream out(fileName.c_str(), std::ios::out);
-    if (!out) {
+    PlotFile *file = createPlotFile(fileName);
+    if (!file) {
         CL_ERROR("unable to create file '" << fileName << "'");
         return false;
     }
 
-    // open graph
-    out << "digraph " << SL_QUOTE(plotName)
-        << " {\n\tlabel=<<FONT POINT-SIZE=\"18\">" << plotName
-        << "</FONT>>;\n\tclusterrank=local;\n\tlabelloc=t;\n";
-
-    // check whether we can write to stream
-    if (!out.flush()) {
-        CL_ERROR("unable to write file '" << fileName << "'");
-        out.close();
-        return false;
-    }
-
     if (loc)
         CL_NOTE_MSG(loc, "writing heap graph to '" << fileName << "'...");
     else
         CL_DEBUG("writing heap graph to '" << fileName << "'...");
 
+    // the graph is only recorded here, plotwriter.hh formats and writes it
+    PlotRecord *out = new PlotRecord;
+
+    // open graph
+    *out << "digraph " << SL_QUOTE(plotName)
+        << " {\n\tlabel=<<FONT POINT-SIZE=\"18\">" << plotName
+        << "</FONT>>;\n\tclusterrank=local;\n\tlabelloc=t;\n";
+
     // initialize an instance of PlotData
-    PlotData plot(sh, out, objs, vals, pHighlight);
+    PlotData plot(sh, *out, objs, vals, pHighlight);
 
     // do our stuff
     plotEverything(plot);
 
     // close graph
-    out << "}\n";
-    const bool ok = !!out;
-    out.close();
-    return ok;
+    *out << "}\n";
+    return writePlotFile(file, out);
 }
 
 // /////////////////////////////////////////////////////////////////////////////
@@ -23,24 +23,24 @@
 #include <cl/cl_msg.hh>
 #include <cl/storage.hh>
 
+#include "glconf.hh"
 #include "symcmp.hh"
 #include "symjoin.hh"
 #include "symplot.hh"
+#include "symstats.hh"
 #include "symutil.hh"
 #include "symtrace.hh"
 #include "util.hh"
 #include "worklist.hh"
 
 #include <algorithm>            // for std::copy_if
+#include <climits>
 #include <iomanip>
 #include <map>
+#include <set>
 
 #include <boost/foreach.hpp>
 
-#if !SE_BLOCK_SCHEDULER_KIND
-#   include <queue>
-#endif
-
 // set to 'true' if you wonder why SymState matches states as it does (noisy)
 static bool debugSymState = static_cast<bool>(DEBUG_SYMSTATE);
 
@@ -236,6 +236,7 @@ bool SymStateWithJoin::insert(const SymHeap &shNew, bool allowThreeWay)
     int             idx;
 
     ++::cntLookups;
+    SymStats::count(SS_JOIN_TRIES);
     for(idx = 0; idx < cnt; ++idx) {
         const SymHeap &shOld = this->operator[](idx);
         if (joinSymHeaps(&status, &result, shOld, shNew, allowThreeWay))
@@ -250,6 +251,7 @@ bool SymStateWithJoin::insert(const SymHeap &shNew, bool allowThreeWay)
     }
 
     CL_BREAK_IF(!allowThreeWay && JS_THREE_WAY == status);
+    SymStats::count(SS_JOIN_HITS);
 
     switch (status) {
         case JS_USE_ANY:
@@ -302,29 +304,220 @@ bool SymStateWithJoin::insert(const SymHeap &shNew, bool allowThreeWay)
 }
 
 
+// /////////////////////////////////////////////////////////////////////////////
+// BlockRanking implementation
+
+/// static priorities of basic blocks used by the priority-driven scheduler
+class BlockRanking {
+    public:
+        typedef BlockScheduler::TBlock                      TBlock;
+        typedef BlockScheduler::TBlockSet                   TBlockSet;
+
+        /// the lower the rank, the sooner the block should be processed
+        long long rankOf(TBlock bb, bool delayLoopHeads);
+
+        /// the ranks are keyed by addresses of blocks owned by a Storage
+        void clear();
+
+    private:
+        struct Rank {
+            unsigned        rpo;        ///< index in reverse post-order
+            unsigned        loopDepth;  ///< count of loops containing the block
+            bool            loopEntry;  ///< see CodeStorage::Block::isLoopEntry
+
+            Rank():
+                rpo(/* not reachable from entry */ UINT_MAX),
+                loopDepth(0U),
+                loopEntry(false)
+            {
+            }
+        };
+
+        typedef const CodeStorage::ControlFlow             *TCfg;
+        typedef std::map<TBlock, Rank>                      TRankMap;
+
+        std::set<TCfg>      analyzed_;
+        TRankMap            ranks_;
+
+        void analyzeCfg(TCfg);
+};
+
+void BlockRanking::analyzeCfg(const TCfg cfg)
+{
+    BOOST_FOREACH(const TBlock bb, *cfg)
+        ranks_[bb].loopEntry = bb->isLoopEntry();
+
+    // compute the post-order by an iterative DFS starting at the entry block
+    typedef std::pair<TBlock, unsigned /* next target */> TDfsItem;
+    std::vector<TDfsItem> dfsStack;
+    std::vector<TBlock> postOrder;
+    std::set<TBlock> seen;
+
+    const TBlock entry = cfg->entry();
+    seen.insert(entry);
+    dfsStack.push_back(TDfsItem(entry, 0U));
+    while (!dfsStack.empty()) {
+        TDfsItem &top = dfsStack.back();
+        const CodeStorage::TTargetList &tList = top.first->targets();
+        if (tList.size() <= top.second) {
+            postOrder.push_back(top.first);
+            dfsStack.pop_back();
+            continue;
+        }
+
+        const TBlock next = tList[top.second++];
+        if (insertOnce(seen, next))
+            dfsStack.push_back(TDfsItem(next, 0U));
+    }
+
+    const unsigned cnt = postOrder.size();
+    for (unsigned idx = 0U; idx < cnt; ++idx)
+        ranks_[postOrder[idx]].rpo = cnt - 1U - idx;
+
+    // collect the natural loops given by the loop-closing edges of the CFG
+    typedef std::map<TBlock /* head */, TBlockSet /* body */> TLoops;
+    TLoops loops;
+    BOOST_FOREACH(const TBlock src, *cfg) {
+        const CodeStorage::Insn *term = src->back();
+        BOOST_FOREACH(const unsigned idx, term->loopClosingTargets) {
+            const TBlock head = term->targets[idx];
+            TBlockSet &body = loops[head];
+            body.insert(head);
+            if (src == head)
+                // a self-loop
+                continue;
+
+            // walk backwards from the closing edge until we reach the head
+            WorkList<TBlock> wl(src);
+            TBlock bb;
+            while (wl.next(bb)) {
+                body.insert(bb);
+                BOOST_FOREACH(const TBlock pred, bb->inbound())
+                    if (pred != head)
+                        wl.schedule(pred);
+            }
+        }
+    }
+
+    BOOST_FOREACH(TLoops::const_reference loop, loops)
+        BOOST_FOREACH(const TBlock bb, /* body */ loop.second)
+            ++ranks_[bb].loopDepth;
+}
+
+long long BlockRanking::rankOf(const TBlock bb, const bool delayLoopHeads)
+{
+    if (insertOnce(analyzed_, bb->cfg()))
+        this->analyzeCfg(bb->cfg());
+
+    const Rank &rank = ranks_[bb];
+
+    // inner loops first, then (optionally) the loop heads last, then RPO
+    long long prio = 0xFFFFU - std::min(rank.loopDepth, 0xFFFFU);
+    prio <<= 1;
+    if (delayLoopHeads && rank.loopEntry)
+        prio |= 1LL;
+
+    prio <<= 32;
+    return prio | rank.rpo;
+}
+
+void BlockRanking::clear()
+{
+    analyzed_.clear();
+    ranks_.clear();
+}
+
+static BlockRanking blockRanking;
+
+
 // /////////////////////////////////////////////////////////////////////////////
 // BlockScheduler implementation
 struct BlockScheduler::Private {
-#if !SE_BLOCK_SCHEDULER_KIND
-    typedef std::queue<TBlock>                              TSched;
-#elif SE_BLOCK_SCHEDULER_KIND < 3
-    typedef std::vector<TBlock>                             TSched;
-#endif
+    /// the block with the lowest priority value is processed first
+    typedef long long                                       TPrio;
+    typedef std::pair<TPrio, TBlock>                        TItem;
+    typedef std::set<TItem>                                 TSched;
+    typedef std::map<TBlock, TPrio>                         TPrioMap;
     typedef std::map<TBlock, unsigned /* cnt */>            TDone;
 
+    const int           kind;       ///< see config.h::SE_BLOCK_SCHEDULER_KIND
     TBlockSet           todo;
-#if SE_BLOCK_SCHEDULER_KIND < 3
-    TSched              sched;
-#endif
+    TSched              sched;      ///< not used by the load-driven scheduler
+    TPrioMap            prioOf;     ///< the current priority of blocks in sched
+    TPrio               stamp;
     TDone               done;
 
     const IPendingCountProvider *pcp;
+
+    Private(const IPendingCountProvider &pcp_):
+        kind(GlConf::data.blockSchedulerKind),
+        stamp(0LL),
+        pcp(&pcp_)
+    {
+    }
+
+    void push(TBlock bb);
+    TBlock pop();
+    TBlock pickLeastLoaded() const;
 };
 
+void BlockScheduler::Private::push(const TBlock bb)
+{
+    TPrio prio;
+    switch (this->kind) {
+        case 0:
+            // BFS
+            prio = ++this->stamp;
+            break;
+
+        case 1:
+        case 2:
+            // DFS
+            prio = -(++this->stamp);
+            break;
+
+        default:
+            prio = blockRanking.rankOf(bb, /* delayLoopHeads */ 5 == this->kind);
+    }
+
+    this->prioOf[bb] = prio;
+    this->sched.insert(TItem(prio, bb));
+}
+
+BlockScheduler::TBlock BlockScheduler::Private::pop()
+{
+    const TSched::iterator it = this->sched.begin();
+    const TBlock bb = it->second;
+    this->sched.erase(it);
+    this->prioOf.erase(bb);
+    return bb;
+}
+
+BlockScheduler::TBlock BlockScheduler::Private::pickLeastLoaded() const
+{
+    TBlock bb = 0;
+    int minPending = INT_MAX;
+
+    BOOST_FOREACH(const TBlock bbNow, this->todo) {
+        const int cntPending = this->pcp->cntPending(bbNow);
+        if (minPending < cntPending)
+            continue;
+
+        // on a tie, the block iterated last (the greatest one in todo) wins
+        minPending = cntPending;
+        bb = bbNow;
+    }
+
+    CL_DEBUG("<Q> load-driven scheduler picks "
+            << bb->name() << " with "
+            << minPending << " pending states");
+
+    return bb;
+}
+
 BlockScheduler::BlockScheduler(const IPendingCountProvider &pcp):
-    d(new Private)
+    d(new Private(pcp))
 {
-    d->pcp = &pcp;
 }
 
 BlockScheduler::BlockScheduler(const BlockScheduler &tpl):
@@ -337,6 +530,11 @@ BlockScheduler::~BlockScheduler()
     delete d;
 }
 
+void BlockScheduler::resetRanking()
+{
+    blockRanking.clear();
+}
+
 unsigned BlockScheduler::cntWaiting() const
 {
     return d->todo.size();
@@ -359,43 +557,33 @@ BlockScheduler::TBlockList BlockScheduler::done() const
 bool BlockScheduler::schedule(const TBlock bb)
 {
     if (insertOnce(d->todo, bb)) {
-#if !SE_BLOCK_SCHEDULER_KIND
-        d->sched.push(bb);
-#elif SE_BLOCK_SCHEDULER_KIND < 3
-        d->sched.push_back(bb);
-#endif
+        if (3 != d->kind)
+            d->push(bb);
+
         return true;
     }
 
     // already in the queue
+    if (2 != d->kind)
+        return false;
 
-#if 2 == SE_BLOCK_SCHEDULER_KIND
-    const int cnt = d->sched.size();
-
-    // seek the given block in the queue
-    int idx;
-    for (idx = cnt - 1; 0 <= idx; --idx)
-        if (bb == d->sched[idx])
-            break;
-
-    if (idx < 0) {
+    const Private::TPrioMap::iterator it = d->prioOf.find(bb);
+    if (d->prioOf.end() == it) {
         // if not found in the queue, consistency of BlockScheduler is broken
         CL_BREAK_IF("BlockScheduler::schedule() detected inconsistency!");
         return false;
     }
 
-    if (idx + 1 == cnt)
+    if (d->sched.begin()->second == bb)
         // already at the top
         return false;
 
-    CL_DEBUG("<Q> prioritizing block " << bb->name()
-            << ", found in depth " << (cnt - idx));
-
-    Private::TSched::iterator itIdx = d->sched.begin() + idx;
-    Private::TSched::iterator itTop = d->sched.begin() + (cnt - 1);
-    rotate(itIdx, itTop, d->sched.end());
-#endif
+    CL_DEBUG("<Q> prioritizing block " << bb->name());
 
+    // move the block to the top of the queue
+    d->sched.erase(Private::TItem(it->second, bb));
+    d->prioOf.erase(it);
+    d->push(bb);
     return false;
 }
 
@@ -405,36 +593,10 @@ bool BlockScheduler::getNext(TBlock *dst)
         return false;
 
     // select the block for processing according to the policy
-    TBlock bb;
-#if !SE_BLOCK_SCHEDULER_KIND
-    bb = d->sched.front();
-    d->sched.pop();
-#elif SE_BLOCK_SCHEDULER_KIND < 3
-    bb = d->sched.back();
-    d->sched.pop_back();
-
-#else // assume load-driven scheduler
-
-    typedef std::map<int /* cntPending */, TBlock> TLoad;
-    TLoad load;
-
-    // this really needs to be sorted in getNext()
-    BOOST_FOREACH(const TBlock bbNow, d->todo) {
-        const int cntPending = d->pcp->cntPending(bbNow);
-        load[cntPending] = bbNow;
-    }
+    const TBlock bb = (3 == d->kind)
+        ? d->pickLeastLoaded()
+        : d->pop();
 
-    const TLoad::const_iterator itTop = load.begin();
-    const TLoad::const_reverse_iterator itBottom = load.rbegin();
-
-    bb = itTop->second;
-
-    CL_DEBUG("<Q> load-driven scheduler picks "
-            << bb->name() << " with "
-            << itTop->first << " pending states, the last one is "
-            << itBottom->second->name() << " with "
-            << itBottom->first << " pending states");   
-#endif
     if (1 != d->todo.erase(bb))
         CL_BREAK_IF("BlockScheduler malfunction");
 
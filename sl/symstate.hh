@@ -322,6 +322,9 @@ class BlockScheduler: public IStatsProvider {
 
         virtual void printStats() const;
 
+        /// forget the ranks of blocks computed so far (once per Storage)
+        static void resetRanking();
+
     private:
         // not implemented
         BlockScheduler& operator=(const BlockScheduler &);
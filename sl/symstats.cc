@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+#include "symstats.hh"
+
+#include <cl/cl_msg.hh>
+#include <cl/memdebug.hh>
+
+static const char *statNames[SS_TOTAL] = {
+    "blocks",
+    "heaps",
+    "paths",
+    "join-tries",
+    "join-hits",
+    "call-lookups",
+    "call-hits"
+};
+
+static unsigned long stats[SS_TOTAL];
+
+void SymStats::reset()
+{
+    for (int ss = 0; ss < SS_TOTAL; ++ss)
+        stats[ss] = 0UL;
+}
+
+void SymStats::count(const ESymStat ss, const unsigned cnt)
+{
+    stats[ss] += cnt;
+}
+
+void SymStats::printReport()
+{
+    std::ostringstream os;
+    for (int ss = 0; ss < SS_TOTAL; ++ss) {
+        if (ss)
+            os << ", ";
+
+        os << statNames[ss] << " " << stats[ss];
+    }
+
+    long mib;
+    if (peakRssUsage(&mib))
+        os << ", peak-rss " << mib << " MiB";
+
+    CL_NOTE("analysis statistics: " << os.str());
+}
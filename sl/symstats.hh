@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef H_GUARD_SYMSTATS_H
+#define H_GUARD_SYMSTATS_H
+
+/**
+ * @file symstats.hh
+ * counters of the work done by the analysis, printed by the @b print_stats
+ * option on a single line so that benchmarking scripts can easily read them
+ */
+
+/// counters maintained by SymStats
+enum ESymStat {
+    SS_BLOCKS = 0,          ///< basic blocks entered by SymExecEngine
+    SS_HEAPS,               ///< heaps executed on the basic block entries
+    SS_PATHS,               ///< heaps that reached a return from a function
+    SS_JOIN_TRIES,          ///< heaps SymStateWithJoin tried to join
+    SS_JOIN_HITS,           ///< heaps SymStateWithJoin managed to join
+    SS_CALL_LOOKUPS,        ///< lookups in the call cache
+    SS_CALL_HITS,           ///< lookups in the call cache that succeeded
+    SS_TOTAL
+};
+
+class SymStats {
+    public:
+        /// reset all the counters, to be called before the analysis
+        static void reset();
+
+        /// add cnt to the given counter
+        static void count(ESymStat, unsigned cnt = 1U);
+
+        /// print all the counters together with the peak memory usage
+        static void printReport();
+
+    private:
+        /// library class
+        SymStats();
+};
+
+#endif /* H_GUARD_SYMSTATS_H */
@@ -21,6 +21,7 @@
 
 #include <cl/cl_msg.hh>
 #include <cl/cldebug.hh>
+#include <cl/plotwriter.hh>
 #include <cl/storage.hh>
 
 #include "plotenum.hh"
@@ -57,6 +58,34 @@ Node* NodeBase::parent() const
 // /////////////////////////////////////////////////////////////////////////////
 // implementation of Trace::Node
 
+/// empty ID mappings of the nodes that have not allocated their own one yet,
+/// indexed by TIdMapper::ENotFoundAction
+static const TIdMapper emptyIdMappers[] = {
+    TIdMapper(TIdMapper::NFA_TRAP_TO_DEBUGGER),
+    TIdMapper(TIdMapper::NFA_RETURN_NOTHING),
+    TIdMapper(TIdMapper::NFA_RETURN_IDENTITY)
+};
+
+Node::~Node()
+{
+    delete idMapper_;
+}
+
+TIdMapper& Node::idMapper()
+{
+    if (!idMapper_)
+        idMapper_ = new TIdMapper(nfa_);
+
+    return *idMapper_;
+}
+
+const TIdMapper& Node::idMapper() const
+{
+    return (idMapper_)
+        ? *idMapper_
+        : emptyIdMappers[nfa_];
+}
+
 void Node::notifyBirth(NodeBase *child)
 {
     children_.push_back(child);
@@ -69,9 +98,28 @@ void Node::notifyDeath(NodeBase *child)
             std::remove(children_.begin(), children_.end(), child),
             children_.end());
 
-    if (children_.empty())
-        // FIXME: this may cause stack overflow on complex trace graphs
-        delete this;
+    if (!children_.empty())
+        return;
+
+    // nodes that have lost all their children and wait for deletion, never
+    // destroyed as heaps may still release their trace nodes at exit
+    static TNodeList &dying = *new TNodeList;
+    static bool deleting;
+
+    dying.push_back(this);
+    if (deleting)
+        // the node is going to be deleted by the loop below in a caller
+        return;
+
+    // delete the whole unreachable sub-graph without recursion, which would
+    // otherwise overflow the stack on long traces
+    deleting = true;
+    while (!dying.empty()) {
+        Node *node = dying.back();
+        dying.pop_back();
+        delete node;
+    }
+    deleting = false;
 }
 
 
@@ -117,10 +165,10 @@ typedef WorkList<TNodePair>             TWorkList;
 static Node *const nullNode = 0;
 
 struct TracePlotter {
-    std::ostream                        &out;
+    PlotRecord                          &out;
     TWorkList                           &wl;
 
-    TracePlotter(std::ostream &out_, TWorkList &wl_):
+    TracePlotter(PlotRecord &out_, TWorkList &wl_):
         out(out_),
         wl(wl_)
     {
@@ -151,10 +199,30 @@ std::string insnToBlock(const TInsn insn)
         : "VAR INITIALIZER";
 }
 
+// the instructions are owned by CodeStorage, we can format them in plotwriter
+void formatInsn(std::ostream &str, const void *obj)
+{
+    str << *static_cast<TInsn>(obj);
+}
+
+void formatInsnLabel(std::ostream &str, const void *obj)
+{
+    str << insnToLabel(static_cast<TInsn>(obj));
+}
+
+void formatInsnLocAndBlock(std::ostream &str, const void *obj)
+{
+    const TInsn insn = static_cast<TInsn>(obj);
+    str << insn->loc << insnToBlock(insn);
+}
+
+#define INSN(insn)       PlotRef(formatInsn, insn)
+#define INSN_LABEL(insn) PlotRef(formatInsnLabel, insn)
+
 // FIXME: copy-pasted from symplot.cc
 #define SL_QUOTE(what) "\"" << what << "\""
 
-#define INSN_LOC_AND_BB(insn) SL_QUOTE((insn)->loc << insnToBlock(insn))
+#define INSN_LOC_AND_BB(insn) SL_QUOTE(PlotRef(formatInsnLocAndBlock, insn))
 
 void TransientNode::plotNode(TracePlotter &tplot) const
 {
@@ -177,7 +245,7 @@ void InsnNode::plotNode(TracePlotter &tplot) const
 
     tplot.out << "\t" << SL_QUOTE(this)
         << " [shape=plaintext, fontname=monospace, fontcolor=" << color
-        << ", label=" << SL_QUOTE(insnToLabel(insn_))
+        << ", label=" << SL_QUOTE(INSN_LABEL(insn_))
         << ", tooltip=" << INSN_LOC_AND_BB(insn_)
         << "];\n";
 }
@@ -238,8 +306,8 @@ void CallEntryNode::plotNode(TracePlotter &tplot) const
 {
     tplot.out << "\t" << SL_QUOTE(this)
         << " [shape=box, fontname=monospace, color=blue, fontcolor=blue"
-        ", penwidth=3.0, label=\"--> call entry: " << (insnToLabel(insn_))
-        << "\", tooltip=\"" << insn_->loc << insn_->bb->name() << "\"];\n";
+        ", penwidth=3.0, label=\"--> call entry: " << INSN_LABEL(insn_)
+        << "\", tooltip=" << INSN_LOC_AND_BB(insn_) << "];\n";
 }
 
 void CallCacheHitNode::plotNode(TracePlotter &tplot) const
@@ -254,7 +322,7 @@ void CallFrameNode::plotNode(TracePlotter &tplot) const
 {
     tplot.out << "\t" << SL_QUOTE(this)
         << " [shape=box, fontname=monospace, color=blue, fontcolor=blue"
-        ", label=\"--- call frame: " << (insnToLabel(insn_))
+        ", label=\"--- call frame: " << INSN_LABEL(insn_)
         << "\", tooltip=" << INSN_LOC_AND_BB(insn_) << "];\n";
 }
 
@@ -282,7 +350,7 @@ void CondNode::plotNode(TracePlotter &tplot) const
     else
         tplot.out << ", color=red";
 
-    tplot.out << ", fontcolor=black, label=\"" << (*inCmp_) << " ... ";
+    tplot.out << ", fontcolor=black, label=\"" << INSN(inCmp_) << " ... ";
 
     if (determ_)
         tplot.out << "evaluated as ";
@@ -321,10 +389,14 @@ void MsgNode::plotNode(TracePlotter &tplot) const
             CL_BREAK_IF("unhandled EMsgLevel in MsgNode");
     }
 
+    // the location need not be owned by CodeStorage, format it right now
+    std::ostringstream locStr;
+    locStr << (*loc_);
+
     tplot.out << "\t" << SL_QUOTE(this)
         << " [shape=tripleoctagon, fontcolor=monospace, color="
         << color << ", fontcolor=red, label="
-        << SL_QUOTE((*loc_) << label) << "];\n";
+        << SL_QUOTE(locStr.str() << label) << "];\n";
 }
 
 void UserNode::plotNode(TracePlotter &tplot) const
@@ -370,33 +442,30 @@ bool plotTrace(const std::string &name, TWorkList &wl, std::string *pName = 0)
         *pName = plotName;
 
     // create a dot file
-    std::fstream out(fileName.c_str(), std::ios::out);
-    if (!out) {
+    PlotFile *file = createPlotFile(fileName);
+    if (!file) {
         CL_ERROR("unable to create file '" << fileName << "'");
         return false;
     }
 
+    // the graph is only recorded here, plotwriter.hh formats and writes it
+    PlotRecord *out = new PlotRecord;
+
     // open graph
-    out << "digraph " << SL_QUOTE(plotName)
+    *out << "digraph " << SL_QUOTE(plotName)
         << " {\n\tlabel=<<FONT POINT-SIZE=\"18\">" << plotName
         << "</FONT>>;\n\tlabelloc=t;\n";
 
-    // check whether we can write to stream
-    if (!out.flush()) {
-        CL_ERROR("unable to write file '" << fileName << "'");
-        out.close();
-        return false;
-    }
-
     // do our stuff
-    TracePlotter tplot(out, wl);
+    TracePlotter tplot(*out, wl);
     plotTraceCore(tplot);
 
     // close graph
-    out << "}\n";
-    out.close();
+    *out << "}\n";
+    const bool ok = writePlotFile(file, out);
+
     CL_NOTE("trace graph dumped to '" << fileName << "'");
-    return !!out;
+    return ok;
 }
 
 bool plotTrace(Node *endPoint, const std::string &name, std::string *pName)
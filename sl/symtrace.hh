@@ -99,18 +99,26 @@ class Node: public NodeBase {
 
     protected:
         /// this is an abstract class, its instantiation is @b not allowed
-        Node() { }
+        Node():
+            nfa_(TIdMapper::NFA_TRAP_TO_DEBUGGER),
+            idMapper_(0)
+        {
+        }
 
         /// constructor for nodes with exactly one parent
         Node(Node *ref):
-            NodeBase(ref)
+            NodeBase(ref),
+            nfa_(TIdMapper::NFA_TRAP_TO_DEBUGGER),
+            idMapper_(0)
         {
             ref->notifyBirth(this);
         }
 
         /// constructor for nodes with exactly two parents
         Node(Node *ref1, Node *ref2):
-            NodeBase(ref1)
+            NodeBase(ref1),
+            nfa_(TIdMapper::NFA_TRAP_TO_DEBUGGER),
+            idMapper_(0)
         {
             parents_.push_back(ref2);
             ref1->notifyBirth(this);
@@ -135,22 +143,33 @@ class Node: public NodeBase {
         }
 
     public:
+        virtual ~Node();
+
         /// return the ID mapping describing the operation behind the trace node
-        TIdMapper& idMapper()             { return idMapper_; }
+        TIdMapper& idMapper();
 
         /// return the ID mapping describing the operation behind the trace node
-        const TIdMapper& idMapper() const { return idMapper_; }
+        const TIdMapper& idMapper() const;
+
+        /// set the not-found action without allocating the ID mapping
+        void setNotFoundAction(const TIdMapper::ENotFoundAction nfa) {
+            nfa_ = nfa;
+            if (idMapper_)
+                idMapper_->setNotFoundAction(nfa);
+        }
 
     private:
         // copying NOT allowed
         Node(const Node &);
         Node& operator=(const Node &);
 
-    protected:
-        TIdMapper idMapper_;
-
     private:
         TBaseList children_;
+
+        /// most of the nodes map IDs as identity, the mapping is thus
+        /// allocated on the first write access only
+        TIdMapper::ENotFoundAction  nfa_;
+        TIdMapper                  *idMapper_;
 };
 
 /// useful to prevent a trace sub-graph from being destroyed too early
@@ -238,7 +257,7 @@ class InsnNode: public Node {
             insn_(insn),
             isBuiltin_(isBuiltin)
         {
-            idMapper_.setNotFoundAction(TIdMapper::NFA_RETURN_IDENTITY);
+            this->setNotFoundAction(TIdMapper::NFA_RETURN_IDENTITY);
         }
 
         virtual Node* printNode() const;
@@ -270,7 +289,7 @@ class CondNode: public Node {
             determ_(determ),
             branch_(branch)
         {
-            idMapper_.setNotFoundAction(TIdMapper::NFA_RETURN_IDENTITY);
+            this->setNotFoundAction(TIdMapper::NFA_RETURN_IDENTITY);
         }
 
         virtual Node* printNode() const;
@@ -342,7 +361,7 @@ class SpliceOutNode: public Node {
             Node(ref),
             len_(len)
         {
-            idMapper_.setNotFoundAction(TIdMapper::NFA_RETURN_IDENTITY);
+            this->setNotFoundAction(TIdMapper::NFA_RETURN_IDENTITY);
         }
 
     protected:
@@ -515,7 +534,7 @@ class MsgNode: public Node {
             level_(level),
             loc_(loc)
         {
-            idMapper_.setNotFoundAction(TIdMapper::NFA_RETURN_IDENTITY);
+            this->setNotFoundAction(TIdMapper::NFA_RETURN_IDENTITY);
         }
 
     protected:
@@ -539,7 +558,7 @@ class UserNode: public Node {
             insn_(insn),
             label_(label)
         {
-            idMapper_.setNotFoundAction(TIdMapper::NFA_RETURN_IDENTITY);
+            this->setNotFoundAction(TIdMapper::NFA_RETURN_IDENTITY);
         }
 
         virtual Node* printNode() const;
@@ -0,0 +1,66 @@
+#include <stdlib.h>
+
+struct node {
+    struct node *next;
+    struct node *prev;
+};
+
+static struct node *gl;
+
+static struct node* alloc_node(void)
+{
+    struct node *node = malloc(sizeof *node);
+    if (!node)
+        abort();
+
+    node->next = NULL;
+    node->prev = NULL;
+    return node;
+}
+
+int main()
+{
+    // a cycle of two objects pointed only by a heap object
+    struct node *h = alloc_node();
+    h->next = alloc_node();
+    h->next->next = alloc_node();
+    h->next->next->next = h->next;
+
+    // the whole cycle leaks as soon as its only referrer is freed
+    free(h);
+
+    // an object pointed by a heap object reachable from a static variable
+    gl = alloc_node();
+    gl->next = alloc_node();
+    h = alloc_node();
+    h->next = gl->next;
+    h->next->prev = h;
+
+    // the object remains reachable through gl->next, no leak here
+    free(h);
+    free(gl->next);
+    free(gl);
+
+    // an acyclic chain of two objects
+    h = alloc_node();
+    h->next = alloc_node();
+    h->next->next = alloc_node();
+
+    // both objects of the chain leak at once
+    free(h);
+
+    return 0;
+}
+
+/**
+ * @file test-0616.c
+ *
+ * @brief a regression test for memory leaks of cycles and chains on heap
+ *
+ * - a heap object reachable from a static variable through another heap
+ *   object is not reported as a leak
+ *
+ * @attention
+ * This description is automatically imported from tests/predator-regre/README.
+ * Any changes made to this comment will be thrown away on the next import.
+ */
@@ -49,9 +49,20 @@ namespace {
 * @param[in] width Bit width of the type that was used to store @a value.
 * @param[in] sign Boolean flag specifies if the type is signed or unsigned.
 */
-Number::Number(Int value, unsigned width, bool sign)
-		:type(INT), intValue(value), sign(sign), bitWidth(width)
+Number::Number(const Int &value, unsigned width, bool sign)
 {
+	initInt(toSmallInt(value), width, sign);
+}
+
+/**
+* @brief Initializes a new integral number, see the constructors.
+*/
+void Number::initInt(SmallInt value, unsigned width, bool sign)
+{
+	this->type = INT;
+	this->intValue = value;
+	this->sign = sign;
+	this->bitWidth = width;
 	setIntLimits();
 	fitIntoBitWidth();
 }
@@ -63,7 +74,7 @@ Number::Number(Int value, unsigned width, bool sign)
 * @param[in] width Bit width of the type that was used to store @a value.
 */
 Number::Number(Float value, unsigned width)
-		:type(FLOAT), floatValue(value), bitWidth(width)
+		:type(FLOAT), intValue(0), floatValue(value), bitWidth(width)
 {
 	setFloatLimits();
 	fitIntoBitWidth();
@@ -100,16 +111,16 @@ Number Number::assign(const Number &n) const
 			//  inf      -2147483648
 			//  nan      -2147483648
 			if (n.isNotNumber() ||
-					n.floatValue < intToFloat(minIntLimit, isSigned()) ||
-					n.floatValue > intToFloat(maxIntLimit, isSigned())) {
+					n.floatValue < smallIntToFloat(minIntLimit, isSigned()) ||
+					n.floatValue > smallIntToFloat(maxIntLimit, isSigned())) {
 				result.intValue = minIntLimit;
 			} else {
-				result.intValue = floatToInt(n.floatValue);
+				result.intValue = toSmallInt(floatToInt(n.floatValue));
 			}
 		}
 	} else if (result.isFloatingPoint()) {
 		if (n.isIntegral()) {
-			result.floatValue = intToFloat(n.intValue, n.isSigned());
+			result.floatValue = smallIntToFloat(n.intValue, n.isSigned());
 		} else if (n.isFloatingPoint()) {
 			result.floatValue = n.floatValue;
 		}
@@ -402,7 +413,13 @@ Number Number::getNegativeInf() const
 Number::Int Number::getInt() const
 {
 	assert(isIntegral());
-	return intValue;
+
+	// The value fits into a C integral type, see fitIntoBitWidth().
+	if (intValue < 0) {
+		return Int(static_cast<long>(intValue));
+	} else {
+		return Int(static_cast<unsigned long>(intValue));
+	}
 }
 
 /**
@@ -463,8 +480,8 @@ void Number::integralPromotion()
 void Number::convertSignedToUnsigned()
 {
 	if (intValue < 0) {
-		Int max = maxIntLimit + 1;
-		Int tmp = -(intValue / max) + 1;
+		SmallInt max = maxIntLimit + 1;
+		SmallInt tmp = -(intValue / max) + 1;
 		intValue = intValue + tmp * max;
 	}
 }
@@ -516,7 +533,8 @@ pair<Number,Number> Number::extensionByCRules(Number first, Number second)
 		// the other operand is converted, without change of type domain, to a type
 		// whose corresponding real type is float.
 		if (second.isIntegral())
-			second.floatValue = intToFloat(second.intValue, second.isSigned());
+			second.floatValue = smallIntToFloat(second.intValue,
+				second.isSigned());
 		second.type = first.type;
 		second.bitWidth = first.bitWidth;
 		second.setFloatLimits();
@@ -602,6 +620,37 @@ Number::Float Number::intToFloat(const Int &n, bool isSigned) {
 	}
 }
 
+/**
+* @brief Converts the given integer into a floating-point number, the same way
+*        as intToFloat() does for @c Int.
+*/
+Number::Float Number::smallIntToFloat(const SmallInt &n, bool isSigned) {
+	if (isSigned) {
+		return Float(static_cast<long>(n));
+	} else {
+		return Float(static_cast<unsigned long>(n));
+	}
+}
+
+/**
+* @brief Converts the given @c Int into @c SmallInt. Only the bits that fit into
+*        the widest C integral type are kept, which is enough as the value is
+*        going to be fitted into a bit width anyway.
+*/
+Number::SmallInt Number::toSmallInt(const Int &n)
+{
+	if (n.fits_slong_p()) {
+		return n.get_si();
+	}
+
+	// Two's complement of the lowest bits (mpz_fdiv_r_2exp() gives a
+	// non-negative remainder even for negative numbers).
+	Int low;
+	mpz_fdiv_r_2exp(low.get_mpz_t(), n.get_mpz_t(),
+		sizeof(unsigned long) * CHAR_BIT);
+	return low.get_ui();
+}
+
 /**
 * @brief According to the type of the number, converts its value to the predefined
 *        limits.
@@ -609,17 +658,17 @@ Number::Float Number::intToFloat(const Int &n, bool isSigned) {
 void Number::fitIntoBitWidth()
 {
 	if (isIntegral()) {
-		if (isSigned()) {
-			Int valuesInBitWidth = 2 * maxIntLimit + 2;
-			intValue -= minIntLimit;
-			if (intValue < 0) {
-				intValue += (-intValue / valuesInBitWidth + 1) * valuesInBitWidth;
-			}
-			intValue %= valuesInBitWidth;
-			intValue += minIntLimit;
+		// Keeps the lowest bits of the value (that may have wrapped around in
+		// SmallInt) and interprets them according to the signedness.
+		const unsigned bits = getNumOfBits();
+		const SmallUInt valuesInBitWidth = SmallUInt(1) << bits;
+		SmallUInt value = static_cast<SmallUInt>(intValue)
+			& (valuesInBitWidth - 1);
+		if (isSigned() && (value >> (bits - 1))) {
+			intValue = static_cast<SmallInt>(value)
+				- static_cast<SmallInt>(valuesInBitWidth);
 		} else {
-			convertSignedToUnsigned();
-			intValue = intValue % (maxIntLimit + 1);
+			intValue = static_cast<SmallInt>(value);
 		}
 	} else if (isFloatingPoint()) {
 		if (floatValue > maxFloatLimit)
@@ -852,8 +901,8 @@ Number operator+(const Number& op1, const Number& op2)
 	Number &n2 = r.second;
 
 	if (n1.isIntegral() && n2.isIntegral()) {
-		Number::Int newValue = n1.intValue + n2.intValue;
-		Number result(newValue, n1.bitWidth, n1.sign);
+		Number result(n1);
+		result.intValue = n1.intValue + n2.intValue;
 		result.fitIntoBitWidth();
 		return result;
 	} else if (n1.isFloatingPoint() && n2.isFloatingPoint()) {
@@ -901,8 +950,8 @@ Number operator-(const Number& op1, const Number& op2)
 	Number &n2 = r.second;
 
 	if (n1.isIntegral() && n2.isIntegral()) {
-		Number::Int newValue = n1.intValue - n2.intValue;
-		Number result(newValue, n1.bitWidth, n1.sign);
+		Number result(n1);
+		result.intValue = n1.intValue - n2.intValue;
 		result.fitIntoBitWidth();
 		return result;
 	} else if (n1.isFloatingPoint() && n2.isFloatingPoint()) {
@@ -950,8 +999,12 @@ Number operator*(const Number& op1, const Number& op2)
 	Number &n2 = r.second;
 
 	if (n1.isIntegral() && n2.isIntegral()) {
-		Number::Int newValue = n1.intValue * n2.intValue;
-		Number result(newValue, n1.bitWidth, n1.sign);
+		// The product may overflow SmallInt, so it is computed with wrapping,
+		// which is fine as only the lowest bits are kept by fitIntoBitWidth().
+		Number result(n1);
+		result.intValue = static_cast<Number::SmallInt>(
+			static_cast<Number::SmallUInt>(n1.intValue) *
+			static_cast<Number::SmallUInt>(n2.intValue));
 		result.fitIntoBitWidth();
 		return result;
 	} else if (n1.isFloatingPoint() && n2.isFloatingPoint()) {
@@ -1031,8 +1084,8 @@ Number exact_div(const Number& op1, const Number& op2)
 	Number &n1 = r.first;
 	Number &n2 = r.second;
 
-	Number::Int newValue = n1.intValue / n2.intValue;
-	Number result(newValue, n1.bitWidth, n1.sign);
+	Number result(n1);
+	result.intValue = n1.intValue / n2.intValue;
 	result.fitIntoBitWidth();
 
 	return result;
@@ -1061,12 +1114,12 @@ Number Number::performTrunc(const Number &op1, const Number& op2, bool isMod)
 	Number &n2 = r.second;
 
 	// Performs operation on the C integral type.
-	Number::Int res;
+	Number::SmallInt res = 0;
 	if ((sizeof(int) == n1.bitWidth)) {
 		if (n1.isSigned()) {
 			int oper1, oper2;
-			oper1 = mpz_get_si(n1.intValue.get_mpz_t());
-			oper2 = mpz_get_si(n2.intValue.get_mpz_t());
+			oper1 = static_cast<long>(n1.intValue);
+			oper2 = static_cast<long>(n2.intValue);
 			if (isMod) {
 				// Computes modulo.
 				res = oper1 % oper2;
@@ -1076,8 +1129,8 @@ Number Number::performTrunc(const Number &op1, const Number& op2, bool isMod)
 			}
 		} else {
 			unsigned oper1, oper2;
-			oper1 = mpz_get_ui(n1.intValue.get_mpz_t());
-			oper2 = mpz_get_ui(n2.intValue.get_mpz_t());
+			oper1 = static_cast<unsigned long>(n1.intValue);
+			oper2 = static_cast<unsigned long>(n2.intValue);
 			if (isMod) {
 				// Computes modulo.
 				res = oper1 % oper2;
@@ -1089,8 +1142,8 @@ Number Number::performTrunc(const Number &op1, const Number& op2, bool isMod)
 	} else if ((sizeof(long) == n1.bitWidth)) {
 		if (n1.isSigned()) {
 			long oper1, oper2;
-			oper1 = mpz_get_si(n1.intValue.get_mpz_t());
-			oper2 = mpz_get_si(n2.intValue.get_mpz_t());
+			oper1 = static_cast<long>(n1.intValue);
+			oper2 = static_cast<long>(n2.intValue);
 			if (isMod) {
 				// Computes modulo.
 				res = oper1 % oper2;
@@ -1100,8 +1153,8 @@ Number Number::performTrunc(const Number &op1, const Number& op2, bool isMod)
 			}
 		} else {
 			unsigned long oper1, oper2;
-			oper1 = mpz_get_ui(n1.intValue.get_mpz_t());
-			oper2 = mpz_get_ui(n2.intValue.get_mpz_t());
+			oper1 = static_cast<unsigned long>(n1.intValue);
+			oper2 = static_cast<unsigned long>(n2.intValue);
 			if (isMod) {
 				// Computes modulo.
 				res = oper1 % oper2;
@@ -1112,9 +1165,10 @@ Number Number::performTrunc(const Number &op1, const Number& op2, bool isMod)
 		}
 	}
 
-	Number result = Number(res, n1.bitWidth, n1.sign);
+	Number result(n1);
+	result.intValue = res;
 	result.fitIntoBitWidth();
-	return result;;
+	return result;
 }
 
 /**
@@ -1200,10 +1254,11 @@ Number bitNot(const Number& op)
 
 	Number promotedOp = op;
 	promotedOp.integralPromotion();
-	Number::Int result;
-	mpz_com(result.get_mpz_t(), promotedOp.intValue.get_mpz_t());
+	Number result(promotedOp);
+	result.intValue = ~promotedOp.intValue;
+	result.fitIntoBitWidth();
 
-	return Number(result, promotedOp.bitWidth, promotedOp.sign);
+	return result;
 }
 
 /**
@@ -1228,28 +1283,26 @@ Number Number::performBitOp(const Number &op1, const Number &op2, char mode)
 	Number &n1 = r.first;
 	Number &n2 = r.second;
 
-	Number::Int res;
+	Number result(n1);
 	switch (mode) {
 		case 'A':
 			// Performs bit and.
-			mpz_and(res.get_mpz_t(), n1.intValue.get_mpz_t(),
-					n2.intValue.get_mpz_t());
+			result.intValue = n1.intValue & n2.intValue;
 			break;
 
 		case 'O':
 			// Performs bit or.
-			mpz_ior(res.get_mpz_t(), n1.intValue.get_mpz_t(),
-					n2.intValue.get_mpz_t());
+			result.intValue = n1.intValue | n2.intValue;
 			break;
 
 		case 'X':
 			// Performs bit xor.
-			mpz_xor(res.get_mpz_t(), n1.intValue.get_mpz_t(),
-					n2.intValue.get_mpz_t());
+			result.intValue = n1.intValue ^ n2.intValue;
 			break;
 	}
 
-	return Number(res, n1.bitWidth, n1.sign);
+	result.fitIntoBitWidth();
+	return result;
 }
 
 /**
@@ -1300,34 +1353,35 @@ Number Number::performShift(Number op1, Number op2, bool isLeft)
 
 	// Shift are not defined for Int, so we have to use left shift from C.
 	// We have to store Int values into C types.
-	Number::Int res;
+	Number::SmallInt res = 0;
 	if ((sizeof(int) == op1.bitWidth)) {
 		if (op1.isSigned()) {
 			int signedOP1, signedOP2;
-			signedOP1 = mpz_get_si(op1.intValue.get_mpz_t());
-			signedOP2 = mpz_get_si(op2.intValue.get_mpz_t());
+			signedOP1 = static_cast<long>(op1.intValue);
+			signedOP2 = static_cast<long>(op2.intValue);
 			res = isLeft ? (signedOP1 << signedOP2) : (signedOP1 >> signedOP2);
 		} else {
 			unsigned signedOP1, signedOP2;
-			signedOP1 = mpz_get_ui(op1.intValue.get_mpz_t());
-			signedOP2 = mpz_get_ui(op2.intValue.get_mpz_t());
+			signedOP1 = static_cast<unsigned long>(op1.intValue);
+			signedOP2 = static_cast<unsigned long>(op2.intValue);
 			res = isLeft ? (signedOP1 << signedOP2) : (signedOP1 >> signedOP2);
 		}
 	} else if ((sizeof(long) == op1.bitWidth)) {
 		if (op1.isSigned()) {
 			long signedOP1, signedOP2;
-			signedOP1 = mpz_get_si(op1.intValue.get_mpz_t());
-			signedOP2 = mpz_get_si(op2.intValue.get_mpz_t());
+			signedOP1 = static_cast<long>(op1.intValue);
+			signedOP2 = static_cast<long>(op2.intValue);
 			res = isLeft ? (signedOP1 << signedOP2) : (signedOP1 >> signedOP2);
 		} else {
 			unsigned long signedOP1, signedOP2;
-			signedOP1 = mpz_get_ui(op1.intValue.get_mpz_t());
-			signedOP2 = mpz_get_ui(op2.intValue.get_mpz_t());
+			signedOP1 = static_cast<unsigned long>(op1.intValue);
+			signedOP2 = static_cast<unsigned long>(op2.intValue);
 			res = isLeft ? (signedOP1 << signedOP2) : (signedOP1 >> signedOP2);
 		}
 	}
 
-	Number result = Number(res, op1.bitWidth, op1.sign);
+	Number result(op1);
+	result.intValue = res;
 	result.fitIntoBitWidth();
 	return result;
 }
@@ -1382,9 +1436,9 @@ Number intToFloat(const Number& op)
 {
 	assert(op.isIntegral());
 	if (op.sign) {
-		return Number((float) mpz_get_si(op.intValue.get_mpz_t()), sizeof(float));
+		return Number((float) static_cast<long>(op.intValue), sizeof(float));
 	} else {
-		return Number((float) mpz_get_ui(op.intValue.get_mpz_t()), sizeof(float));
+		return Number((float) static_cast<unsigned long>(op.intValue), sizeof(float));
 	}
 }
 
@@ -1428,7 +1482,7 @@ Number max(const Number &op1, const Number &op2)
 ostream& operator<<(ostream &os, const Number &n)
 {
 	if (n.isIntegral())
-		os << n.intValue;
+		os << n.getInt();
 	else if (n.isFloatingPoint()) {
 		os << n.floatValue;
 	}
@@ -14,6 +14,9 @@
 #include <utility>
 #include <gmpxx.h>
 
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/utility/enable_if.hpp>
+
 /**
 * @brief Class that represents a number that can be integral or floating-point type.
 *
@@ -22,6 +25,12 @@
 * width of the number solves the overflowing. So, instance of this class can represent
 * all C-language types and can simulate the behaviour of these types. It also takes
 * care of integral promotions and type extensions according to the C rules.
+*
+* Integral values are kept in a machine integer (@c SmallInt) that is wide
+* enough to hold a value of any C integral type. The arithmetic on it wraps
+* around modulo 2^128, which does not change the result once it is fitted into
+* the (narrower) bit width of the number. GMP is used only when converting from
+* or to @c Int.
 */
 class Number {
 	private:
@@ -34,6 +43,12 @@ class Number {
 		/// Biggest integer.
 		typedef mpz_class Int;
 
+		/// Machine integer holding the value of an integral number.
+		__extension__ typedef __int128 SmallInt;
+
+		/// Unsigned counterpart of @c SmallInt, used for wrapping arithmetic.
+		__extension__ typedef unsigned __int128 SmallUInt;
+
 		/// Biggest float.
 		typedef long double Float;
 
@@ -41,7 +56,7 @@ class Number {
 		Type type;
 
 		/// Value of the number if @c type of the number is @c INT.
-		Int intValue;
+		SmallInt intValue;
 
 		/// Value of the number if @c type of the number is @c FLOAT.
 		Float floatValue;
@@ -55,11 +70,11 @@ class Number {
 
 		/// Minimal value that can be stored in the number. It is used only if
 		/// @c type of the number is @c INT.
-		Int minIntLimit;
+		SmallInt minIntLimit;
 
 		/// Maximal value that can be stored in the number. It is used only if
 		/// @c type of the number is @c INT.
-		Int maxIntLimit;
+		SmallInt maxIntLimit;
 
 		/// Minimal value that can be stored in the number. It is used only if
 		/// @c type of the number is @c FLOAT.
@@ -74,13 +89,28 @@ class Number {
 		void fitIntoBitWidth();
 		void integralPromotion();
 		void convertSignedToUnsigned();
+		void initInt(SmallInt value, unsigned width, bool sign);
+
+		static SmallInt toSmallInt(const Int &n);
+		static Float smallIntToFloat(const SmallInt &n, bool isSigned);
 
 		static Number performTrunc(const Number &op1, const Number &op2, bool isMod);
 		static Number performBitOp(const Number &op1, const Number &op2, char mode);
 		static Number performShift(Number op1, Number op2, bool isLeft);
 
 	public:
-		Number(Int value, unsigned width, bool sign);
+		Number(const Int &value, unsigned width, bool sign);
+
+		/**
+		* @brief Constructs a new number from a value of a C integral type
+		*        without going through @c Int.
+		*/
+		template <typename T>
+		Number(T value, unsigned width, bool sign,
+			   typename boost::enable_if<boost::is_integral<T> >::type * = 0)
+		{
+			initInt(static_cast<SmallInt>(value), width, sign);
+		}
 		Number(Float value, unsigned width);
 
 		Number assign(const Number &n) const;
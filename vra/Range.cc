@@ -46,6 +46,27 @@ bool compareLowerBounds(const Range::Interval &i1, const Range::Interval &i2)
 		   (i1.first == i2.first && i1.second < i2.second);
 }
 
+/**
+* @brief Returns @c true if @a n1 and @a n2 are the same numbers of the same
+*        type. Unlike operator==(), floats are not compared with an epsilon
+*        and the bit width and signedness have to match, too.
+*/
+bool identical(const Number &n1, const Number &n2)
+{
+	if (n1.isIntegral() != n2.isIntegral() ||
+		n1.getBitWidth() != n2.getBitWidth()) {
+		return false;
+	}
+
+	if (n1.isIntegral()) {
+		return n1.getSign() == n2.getSign() && n1.getInt() == n2.getInt();
+	}
+
+	const long double f1 = n1.getFloat();
+	const long double f2 = n2.getFloat();
+	return (f1 == f2) || (f1 != f1 && f2 != f2);
+}
+
 }
 
 // Definition of static variables and constants.
@@ -139,7 +160,7 @@ void Range::normalize()
 		return;
 
 	// Only one NAN interval is kept.
-	vector<Interval> tmp;
+	IntervalVector tmp;
 	bool isNanThere = false;
 	for (iterator it = data.begin(); it != data.end(); ++it) {
 		if (it->first.isNotNumber() || it->second.isNotNumber()) {
@@ -828,6 +849,34 @@ bool operator!=(const Range &r1, const Range &r2)
 	return r1.data != r2.data;
 }
 
+/**
+* @brief Checks whether ranges consist of identical intervals.
+*
+* Unlike operator==(), the bounds of the intervals have to be the same numbers
+* of the same type, floats are not compared with an epsilon.
+*
+* @param[in] r1 The first range for comparison.
+* @param[in] r2 The second range for comparison.
+*
+* @return @c true if ranges are identical, @c false otherwise.
+*/
+bool identical(const Range &r1, const Range &r2)
+{
+	if (r1.size() != r2.size()) {
+		return false;
+	}
+
+	for (Range::const_iterator it = r1.begin(), jt = r2.begin();
+		 it != r1.end(); ++it, ++jt) {
+		if (!identical(it->first, jt->first) ||
+			!identical(it->second, jt->second)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
 /**
 * @brief Checks whether ranges @a r1 and @a r2 are equal and returns the
 *        resulting range that can contain three types of intervals: [0,0],
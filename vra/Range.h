@@ -8,11 +8,182 @@
 #ifndef GUARD_RANGE_H
 #define GUARD_RANGE_H
 
-#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <new>
 #include <utility>
 
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+
 #include "Number.h"
 
+/**
+* @brief Sequence of elements with the subset of the @c std::vector interface
+*        that is used by the Range class.
+*
+* Up to @a N elements are stored inline in the object itself, so that no memory
+* is allocated for short sequences, which are the common case for ranges.
+*/
+template <typename T, size_t N>
+class InlineVector {
+	public:
+		typedef T* iterator;
+		typedef const T* const_iterator;
+		typedef std::reverse_iterator<iterator> reverse_iterator;
+		typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+		typedef size_t size_type;
+
+		InlineVector(): ptr(inlineData()), count(0), capacity(N) {}
+
+		InlineVector(const InlineVector &v):
+			ptr(inlineData()), count(0), capacity(N)
+		{
+			append(v);
+		}
+
+		~InlineVector()
+		{
+			clear();
+			release();
+		}
+
+		InlineVector& operator=(const InlineVector &v)
+		{
+			if (this != &v) {
+				clear();
+				append(v);
+			}
+			return *this;
+		}
+
+		iterator begin()             { return ptr; }
+		const_iterator begin() const { return ptr; }
+		iterator end()               { return ptr + count; }
+		const_iterator end() const   { return ptr + count; }
+
+		reverse_iterator rbegin()             { return reverse_iterator(end()); }
+		const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+		reverse_iterator rend()               { return reverse_iterator(begin()); }
+		const_reverse_iterator rend() const   { return const_reverse_iterator(begin()); }
+
+		size_type size() const { return count; }
+		bool empty() const     { return count == 0; }
+
+		T& operator[](size_type i)             { return ptr[i]; }
+		const T& operator[](size_type i) const { return ptr[i]; }
+		T& front()                             { return ptr[0]; }
+		const T& front() const                 { return ptr[0]; }
+		T& back()                              { return ptr[count - 1]; }
+		const T& back() const                  { return ptr[count - 1]; }
+
+		void push_back(const T &item)
+		{
+			if (count == capacity) {
+				// The item may live in this sequence, so copy it first.
+				T copy(item);
+				grow();
+				new (ptr + count) T(copy);
+			} else {
+				new (ptr + count) T(item);
+			}
+			++count;
+		}
+
+		void clear()
+		{
+			for (size_type i = 0; i < count; ++i) {
+				ptr[i].~T();
+			}
+			count = 0;
+		}
+
+		void swap(InlineVector &v)
+		{
+			if (ptr != inlineData() && v.ptr != v.inlineData()) {
+				// Both sequences are allocated, just swap the pointers.
+				std::swap(ptr, v.ptr);
+				std::swap(count, v.count);
+				std::swap(capacity, v.capacity);
+			} else {
+				InlineVector tmp(*this);
+				*this = v;
+				v = tmp;
+			}
+		}
+
+		friend bool operator==(const InlineVector &v1, const InlineVector &v2)
+		{
+			return v1.size() == v2.size() &&
+				std::equal(v1.begin(), v1.end(), v2.begin());
+		}
+
+		friend bool operator!=(const InlineVector &v1, const InlineVector &v2)
+		{
+			return !(v1 == v2);
+		}
+
+	private:
+		/// Inline storage for the first @a N elements.
+		typename boost::aligned_storage<N * sizeof(T),
+			boost::alignment_of<T>::value>::type storage;
+
+		/// Points either to the inline storage or to the allocated memory.
+		T *ptr;
+
+		/// Number of the stored elements.
+		size_type count;
+
+		/// Number of elements that fit into the memory pointed by @c ptr.
+		size_type capacity;
+
+		T* inlineData() { return reinterpret_cast<T *>(&storage); }
+
+		void append(const InlineVector &v)
+		{
+			for (const_iterator it = v.begin(); it != v.end(); ++it) {
+				push_back(*it);
+			}
+		}
+
+		void grow()
+		{
+			const size_type maxCapacity = static_cast<size_type>(-1) / sizeof(T);
+			if (capacity >= maxCapacity / 2) {
+				throw std::bad_alloc();
+			}
+
+			// The compiler cannot prove that capacity is nonzero, so make
+			// the room for at least one more element explicit.
+			const size_type newCapacity = std::max<size_type>(2 * capacity, count + 1);
+			T *newPtr = static_cast<T *>(::operator new(newCapacity * sizeof(T)));
+			for (size_type i = 0; i < count; ++i) {
+				new (newPtr + i) T(ptr[i]);
+				ptr[i].~T();
+			}
+
+			release();
+			ptr = newPtr;
+			capacity = newCapacity;
+		}
+
+		void release()
+		{
+			if (ptr != inlineData()) {
+				::operator delete(ptr);
+			}
+		}
+};
+
+/**
+* @brief Swaps the contents of @a v1 and @a v2.
+*/
+template <typename T, size_t N>
+void swap(InlineVector<T, N> &v1, InlineVector<T, N> &v2)
+{
+	v1.swap(v2);
+}
+
 /**
 * @brief Class that represents the value range of the variable.
 *
@@ -28,17 +199,21 @@ class Range {
 		/// Definition of interval.
 		typedef std::pair<Number, Number> Interval;
 
+		/// Definition of the sequence of intervals, most ranges consist of one
+		/// or two intervals, which are stored without allocating memory.
+		typedef InlineVector<Interval, 2> IntervalVector;
+
 		/// Definition of the iterator for the Range class.
-		typedef std::vector<Interval>::iterator iterator;
+		typedef IntervalVector::iterator iterator;
 
 		/// Definition of the constant iterator for the Range class.
-		typedef std::vector<Interval>::const_iterator const_iterator;
+		typedef IntervalVector::const_iterator const_iterator;
 
 		/// Definition of the reverse iterator for the Range class.
-		typedef std::vector<Interval>::reverse_iterator reverse_iterator;
+		typedef IntervalVector::reverse_iterator reverse_iterator;
 
 		/// Definition of the constant iterator for the Range class.
-		typedef std::vector<Interval>::const_reverse_iterator const_reverse_iterator;
+		typedef IntervalVector::const_reverse_iterator const_reverse_iterator;
 
 		/// Definition of the type for expressing size.
 		typedef size_t size_type;
@@ -111,6 +286,7 @@ class Range {
 
 		friend bool operator==(const Range &r1, const Range &r2);
 		friend bool operator!=(const Range &r1, const Range &r2);
+		friend bool identical(const Range &r1, const Range &r2);
 
 		friend Range logicalEq(const Range &r1, const Range &r2);
 		friend Range logicalNeq(const Range &r1, const Range &r2);
@@ -174,7 +350,7 @@ class Range {
 			extensionByCRules(const Range &r1, const Range &r2);
 
 		/// Stores the intervals.
-		std::vector<Interval> data;
+		IntervalVector data;
 
 		/// Maximal number of intervals in a range (after that,
 		/// mergeIntervals() is automatically called).
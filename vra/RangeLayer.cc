@@ -0,0 +1,215 @@
+/**
+* @author agent, agent@local
+* @file   RangeLayer.cc
+* @brief  Ranges of memory places stored as differences to another layer.
+* @date   2026
+*/
+
+#undef NDEBUG   // It is necessary for using assertions.
+
+#include <boost/foreach.hpp>
+#include <cassert>
+
+#include "RangeLayer.h"
+
+namespace {
+
+/**
+* @brief Returns @c true if both @a r1 and @a r2 are missing or if they are
+*        identical ranges.
+*/
+bool identicalOrMissing(const Range *r1, const Range *r2)
+{
+	if (r1 == NULL || r2 == NULL) {
+		return r1 == r2;
+	}
+
+	return identical(*r1, *r2);
+}
+
+}
+
+/**
+* @brief Constructs a layer that contains no ranges and has no base layer.
+*/
+RangeLayer::RangeLayer(): base(NULL), valid(false), count(0)
+{
+}
+
+/**
+* @brief Sets the layer that the ranges of this layer are based on.
+*
+* Preconditions:
+*  - The layer contains no ranges yet.
+*/
+void RangeLayer::setBase(RangeLayer *layer)
+{
+	assert(!valid && own.empty());
+	base = layer;
+	base->dependents.push_back(this);
+}
+
+/**
+* @brief Makes this layer a root layer that contains the given @a ranges.
+*
+* Preconditions:
+*  - The layer contains no ranges yet and has no base layer.
+*/
+void RangeLayer::setRoot(const MemoryPlaceToRangeMap &ranges)
+{
+	assert(!valid && own.empty() && base == NULL);
+	BOOST_FOREACH(const MemoryPlaceToRangeMap::value_type &item, ranges) {
+		own[item.first] = Entry(&item.second);
+	}
+
+	valid = true;
+	count = own.size();
+}
+
+/**
+* @brief Makes the layer contain the same ranges as its base layer.
+*
+* Preconditions:
+*  - The layer contains no ranges yet and has a base layer.
+*  - No layer based on this one contains any ranges.
+*/
+void RangeLayer::setValid()
+{
+	assert(!valid && own.empty() && base != NULL);
+	BOOST_FOREACH(const RangeLayer *dependent, dependents) {
+		assert(!dependent->valid);
+		(void) dependent;
+	}
+
+	valid = true;
+	count = base->size();
+}
+
+/**
+* @brief Returns the range of the memory place @a mp in the layer or @c NULL
+*        if the layer does not contain @a mp.
+*/
+const Range *RangeLayer::find(const MemoryPlace *mp) const
+{
+	if (!valid) {
+		return NULL;
+	}
+
+	for (const RangeLayer *layer = this; layer != NULL; layer = layer->base) {
+		EntryMap::const_iterator it = layer->own.find(mp);
+		if (it != layer->own.end()) {
+			return it->second.present ? &it->second.range : NULL;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+* @brief Sets the @a range of the memory place @a mp, @c NULL removes @a mp
+*        from the layer.
+*
+* The previous range of @a mp is kept in the layers based on this one.
+*
+* Preconditions:
+*  - The layer is valid.
+*
+* @return @c false if the layer already contains the identical range.
+*/
+bool RangeLayer::set(const MemoryPlace *mp, const Range *range)
+{
+	assert(valid);
+
+	const Range *current = find(mp);
+	if (identicalOrMissing(current, range)) {
+		return false;
+	}
+
+	const Entry previous(current);
+	BOOST_FOREACH(RangeLayer *dependent, dependents) {
+		if (dependent->valid) {
+			// Inserts nothing if the dependent layer has its own entry.
+			dependent->own.insert(EntryMap::value_type(mp, previous));
+		}
+	}
+
+	if (current == NULL) {
+		++count;
+	} else if (range == NULL) {
+		--count;
+	}
+
+	if (base != NULL && identicalOrMissing(base->find(mp), range)) {
+		// There is no need to store the same range as the base layer has.
+		own.erase(mp);
+	} else if (base == NULL && range == NULL) {
+		own.erase(mp);
+	} else {
+		own[mp] = Entry(range);
+	}
+
+	return true;
+}
+
+/**
+* @brief Inserts the memory places that this layer stores by itself into
+*        @a places.
+*/
+void RangeLayer::collectOwnPlaces(MemoryPlaceSet &places) const
+{
+	BOOST_FOREACH(const EntryMap::value_type &item, own) {
+		places.insert(item.first);
+	}
+}
+
+/**
+* @brief Inserts the memory places that can have different ranges in this
+*        layer and in the given @a ancestor layer into @a places.
+*
+* These are the memory places stored by the layers on the way from this layer
+* to @a ancestor. If @a ancestor is @c NULL, all memory places of the layer
+* are inserted.
+*
+* Preconditions:
+*  - The @a ancestor layer is @c NULL or it is reachable through the base
+*    layers.
+*/
+void RangeLayer::collectPlacesUpTo(const RangeLayer *ancestor,
+								   MemoryPlaceSet &places) const
+{
+	for (const RangeLayer *layer = this; layer != ancestor;
+		 layer = layer->base) {
+		assert(layer != NULL);
+		layer->collectOwnPlaces(places);
+	}
+}
+
+/**
+* @brief Returns all ranges of the layer.
+*/
+RangeLayer::MemoryPlaceToRangeMap RangeLayer::getRanges() const
+{
+	MemoryPlaceToRangeMap result;
+	if (!valid) {
+		return result;
+	}
+
+	std::vector<const RangeLayer*> layers;
+	for (const RangeLayer *layer = this; layer != NULL; layer = layer->base) {
+		layers.push_back(layer);
+	}
+
+	// Applies the differences from the root layer to this one.
+	for (std::vector<const RangeLayer*>::reverse_iterator it = layers.rbegin();
+		 it != layers.rend(); ++it) {
+		BOOST_FOREACH(const EntryMap::value_type &item, (*it)->own) {
+			if (item.second.present) {
+				result[item.first] = item.second.range;
+			} else {
+				result.erase(item.first);
+			}
+		}
+	}
+
+	return result;
+}
@@ -0,0 +1,102 @@
+/**
+* @author agent, agent@local
+* @file   RangeLayer.h
+* @brief  Ranges of memory places stored as differences to another layer.
+* @date   2026
+*/
+
+#ifndef GUARD_RANGE_LAYER_H
+#define GUARD_RANGE_LAYER_H
+
+#include <map>
+#include <set>
+#include <vector>
+
+#include "Range.h"
+#include "MemoryPlace.h"
+
+/**
+* @brief Ranges of memory places stored as differences to a base layer.
+*
+* The layers of one function form a tree. The input ranges of a block are
+* based on the output ranges of its immediate dominator and the output ranges
+* of a block are based on its input ranges. The root layer (the input of the
+* entry block) stores all its ranges by itself. Other layers store only the
+* memory places whose ranges differ from their base layer, possibly recording
+* that a memory place is missing there although the base layer has it.
+*
+* Every layer behaves like a complete map of ranges. Therefore, before a range
+* in a layer changes, the previous range is copied into each layer that is
+* based on it and that does not store the memory place itself.
+*
+* A layer that is not valid yet (its block was not reached or analysed so far)
+* contains no ranges at all.
+*/
+class RangeLayer {
+	public:
+		/// Type of the complete ranges of a layer.
+		typedef std::map<const MemoryPlace*, Range> MemoryPlaceToRangeMap;
+
+		/// Type for a set of memory places.
+		typedef std::set<const MemoryPlace*> MemoryPlaceSet;
+
+		RangeLayer();
+
+		void setBase(RangeLayer *base);
+		void setRoot(const MemoryPlaceToRangeMap &ranges);
+
+		/// Returns @c true if the layer contains any ranges.
+		bool isValid() const { return valid; }
+
+		void setValid();
+
+		/// Returns the number of memory places in the layer.
+		size_t size() const { return valid ? count : 0; }
+
+		const Range *find(const MemoryPlace *mp) const;
+
+		bool set(const MemoryPlace *mp, const Range *range);
+
+		void collectOwnPlaces(MemoryPlaceSet &places) const;
+		void collectPlacesUpTo(const RangeLayer *ancestor,
+							   MemoryPlaceSet &places) const;
+
+		MemoryPlaceToRangeMap getRanges() const;
+
+	private:
+		/// Range stored for a memory place by the layer itself.
+		struct Entry {
+			/// @c false if the memory place is missing in the layer.
+			bool present;
+
+			/// Range of the memory place if it is present.
+			Range range;
+
+			Entry(): present(false) {}
+			Entry(const Range *r): present(r != NULL) {
+				if (r != NULL) {
+					range = *r;
+				}
+			}
+		};
+
+		/// Type of the ranges stored by the layer itself.
+		typedef std::map<const MemoryPlace*, Entry> EntryMap;
+
+		/// Layer that the ranges are based on, @c NULL for the root layer.
+		RangeLayer *base;
+
+		/// Layers based on this one.
+		std::vector<RangeLayer*> dependents;
+
+		/// Ranges that differ from the base layer or all ranges of the root.
+		EntryMap own;
+
+		/// @c false if the layer contains no ranges yet.
+		bool valid;
+
+		/// Number of memory places in the layer.
+		size_t count;
+};
+
+#endif
@@ -36,11 +36,14 @@ using std::sort;
 using std::pair;
 
 ValueAnalysis::BlockToTrimmedRangesMap ValueAnalysis::blockToTrimmedRangesMap;
-ValueAnalysis::BlockToResultMap ValueAnalysis::blockToInputRangesMap;
-ValueAnalysis::BlockToResultMap ValueAnalysis::blockToOutputRangesMap;
+ValueAnalysis::BlockToRangesMap ValueAnalysis::blockToRangesMap;
+ValueAnalysis::BlockToBlockMap ValueAnalysis::blockToDominatorMap;
+ValueAnalysis::BlockToInsnEffectsMap ValueAnalysis::blockToInsnEffectsMap;
+RangeLayer::MemoryPlaceSet ValueAnalysis::unstablePlaces;
 ValueAnalysis::SchedulerQueue ValueAnalysis::todoQueue;
 ValueAnalysis::SchedulerSet ValueAnalysis::todoSet;
 ValueAnalysis::BlockToCounterMap ValueAnalysis::blockToCounterMap;
+ValueAnalysis::SchedulerSet ValueAnalysis::expandedBlocks;
 LoopFinder::BlockToUpperLimit ValueAnalysis::tripCountOfBlockMap;
 
 const unsigned ValueAnalysis::NumberOfPassesBeforeExpand = 1000;
@@ -57,6 +60,29 @@ bool sortBlockInfo(const ValueAnalysis::MemoryPlaceRangePair &f,
 	return f.first->asString() < s.first->asString();
 }
 
+/**
+* @brief Returns @c true if joining @a range with itself or with an empty range
+*        gives identical @a range.
+*/
+bool isStable(const Range &range)
+{
+	return identical(unite(range, range), range) &&
+		identical(unite(Range(), range), range);
+}
+
+/**
+* @brief Returns @c true if both @a r1 and @a r2 are missing or if they are
+*        equal ranges.
+*/
+bool equalOrMissing(const Range *r1, const Range *r2)
+{
+	if (r1 == NULL || r2 == NULL) {
+		return r1 == r2;
+	}
+
+	return *r1 == *r2;
+}
+
 }
 
 /**
@@ -78,7 +104,7 @@ void ValueAnalysis::scheduleBlock(const Block *block) {
 *        Otherwise, maximal possible range is returned.
 */
 Range ValueAnalysis::getRange(const struct cl_operand &src,
-							  MemoryPlaceToRangeMap &output,
+							  CurrentRanges &output,
 							  deque<int> indexes)
 {
 	Range srcRange;
@@ -90,14 +116,14 @@ Range ValueAnalysis::getRange(const struct cl_operand &src,
 	} else if (src.code == CL_OPERAND_VAR) {
 		// Right operand of the unary operation is a variable.
 		MemoryPlace *srcVar = OperandToMemoryPlace::convert(&src, indexes);
-		if (output.find(srcVar) != output.end()) {
-			srcRange = output[srcVar];
+		if (const Range *range = output.find(srcVar)) {
+			srcRange = *range;
 		} else {
 			// If we do not know what is in the variable, we set the maximal
 			// possible range. This is used also for the assignment of structure
 			// to another structure.
 			srcRange = Utility::getMaxRange(src, indexes);
-			output[srcVar] = srcRange;
+			output.set(srcVar, srcRange);
 		}
 	}
 
@@ -116,7 +142,7 @@ Range ValueAnalysis::getRange(const struct cl_operand &src,
 */
 void ValueAnalysis::assignSimpleElement(const struct cl_operand &dst,
 										const struct cl_operand &src,
-										MemoryPlaceToRangeMap &output,
+										CurrentRanges &output,
 										deque<int> indDst,
 										deque<int> indSrc)
 {
@@ -130,13 +156,13 @@ void ValueAnalysis::assignSimpleElement(const struct cl_operand &dst,
 
 	if (dstVar->representsElementOfArray()) {
 		// There is an array in this structure.
-		Range result = unite(output[dstVar], srcRange);
+		Range result = unite(output.get(dstVar), srcRange);
 		dstRange = dstRange.assign(result);
-		output[dstVar] = dstRange;
+		output.set(dstVar, dstRange);
 	} else {
 		// No array in this structure.
 		dstRange = dstRange.assign(srcRange);
-		output[dstVar] = dstRange;
+		output.set(dstVar, dstRange);
 	}
 }
 
@@ -189,7 +215,7 @@ const struct cl_type *ValueAnalysis::getType(const struct cl_operand &op)
 */
 void ValueAnalysis::assign(const struct cl_operand &dst,
 						   const struct cl_operand &src,
-						   MemoryPlaceToRangeMap &output)
+						   CurrentRanges &output)
 {
 	// Checks if left operand is valid.
 	assert(dst.code == CL_OPERAND_VAR);
@@ -221,72 +247,80 @@ void ValueAnalysis::assign(const struct cl_operand &dst,
 }
 
 /**
-* @brief If the given @a block is found as a key in the given @a inputMap
-*        then it returns the ranges associated with this key in @a inputMap.
-*        Otherwise, it returns an empty map.
+* @brief Returns the range of the memory place @a mp seen by the currently
+*        analysed instruction or @c NULL if there is no such range.
 */
-ValueAnalysis::MemoryPlaceToRangeMap ValueAnalysis::getRanges(const Block* block,
-													const BlockToResultMap &inputMap)
+const Range *ValueAnalysis::CurrentRanges::find(const MemoryPlace *mp)
 {
-	BlockToResultMap::const_iterator it = inputMap.find(block);
-	if (it != inputMap.end()) {
-		return it->second;
-	} else {
-		MemoryPlaceToRangeMap emptyMap;
-		return emptyMap;
+	if (effect != NULL) {
+		effect->reads.insert(mp);
+	}
+
+	MemoryPlaceToRangeMap::const_iterator it = assigned.find(mp);
+	if (it != assigned.end()) {
+		return &it->second;
 	}
+
+	return input.find(mp);
 }
 
 /**
-* @brief If the given @a block is found as a key in @c blockToTrimmedRangesMap
-*        then it returns the output ranges that get off the given @a block.
-*        Otherwise, it returns an empty map.
+* @brief Returns the range of the memory place @a mp seen by the currently
+*        analysed instruction or an empty range if there is no such range.
 */
-ValueAnalysis::TrimmedRangesMap ValueAnalysis::getTrimmedRanges(const Block* block)
+Range ValueAnalysis::CurrentRanges::get(const MemoryPlace *mp)
 {
-	if (blockToTrimmedRangesMap.find(block) != blockToTrimmedRangesMap.end()) {
-		return blockToTrimmedRangesMap[block];
-	} else {
-		TrimmedRangesMap emptyMap;
-		return emptyMap;
+	const Range *range = find(mp);
+	return (range != NULL) ? *range : Range();
+}
+
+/**
+* @brief Assigns the @a range to the memory place @a mp.
+*/
+void ValueAnalysis::CurrentRanges::set(const MemoryPlace *mp,
+									   const Range &range)
+{
+	if (effect != NULL) {
+		effect->writes[mp] = range;
+	}
+
+	assigned[mp] = range;
+}
+
+/**
+* @brief Sets the @a range of the memory place @a mp in the given @a layer,
+*        @c NULL removes @a mp from the @a layer.
+*
+* The memory places whose ranges change by joining them with themselves or
+* with an empty range are remembered, see computeInputRanges().
+*/
+void ValueAnalysis::setRange(RangeLayer &layer, const MemoryPlace *mp,
+							 const Range *range)
+{
+	if (layer.set(mp, range) && range != NULL && !isStable(*range)) {
+		unstablePlaces.insert(mp);
 	}
 }
 
 /**
-* @brief Computes the partial input ranges for the given block @a current from
-*        the given output ranges of its predecessor stored in @a outs and from
-*        the given trimmed ranges of its predecessor stored in @a trimmed.
+* @brief Returns the trimmed ranges that the predecessor @a pred computed for
+*        the block @a current.
 */
-ValueAnalysis::MemoryPlaceToRangeMap ValueAnalysis::computePartialInputRanges(
-	const CodeStorage::Block *current, const MemoryPlaceToRangeMap &outs,
-	const TrimmedRangesMap &trimmed)
+ValueAnalysis::MemoryPlaceToRangeMap ValueAnalysis::getTrimmedRanges(
+	const CodeStorage::Block *current, const CodeStorage::Block *pred)
 {
 	MemoryPlaceToRangeMap result;
 
-	BOOST_FOREACH(const TrimmedRangesMap::value_type &trim, trimmed) {
-		// Firstly, we choose all trimmed ranges that are valid for the given block
-		// and store them as result.
-		const struct TrimmedKey key = trim.first;
-		const Range &range = trim.second;
-		if (key.block == current) {
-			// If the trimmed range was computed for the current block, we set
-			// the variable for which the trimmed range was computed and store
-			// this trimmed range into the result map.
-			MemoryPlaceToRangeMap::const_iterator it = outs.find(key.varMp);
-			if (it != outs.end() && !(intersect(range, it->second)).empty()) {
-				result[key.varMp] = range;
-			}
-		}
+	BlockToTrimmedRangesMap::const_iterator trimIt =
+		blockToTrimmedRangesMap.find(pred);
+	if (trimIt == blockToTrimmedRangesMap.end()) {
+		return result;
 	}
 
-	BOOST_FOREACH(const MemoryPlaceToRangeMap::value_type &out, outs) {
-		// Secondly, we choose the output ranges for variables that do not have
-		// trimmed ranges set.
-		const MemoryPlace *mp = out.first;
-		const Range &range = out.second;
-		if (result.find(mp) == result.end()) {
-			// If there was no trimming for this memory place, we just add it.
-			result[mp] = range;
+	BOOST_FOREACH(const TrimmedRangesMap::value_type &trim, trimIt->second) {
+		// We choose all trimmed ranges that are valid for the given block.
+		if (trim.first.block == current) {
+			result[trim.first.varMp] = trim.second;
 		}
 	}
 
@@ -297,91 +331,176 @@ ValueAnalysis::MemoryPlaceToRangeMap ValueAnalysis::computePartialInputRanges(
 * @brief Computes the input ranges of the @a current block from the output ranges and
 *        trimmed ranges of predecessors' ranges. Trimmed ranges represents the ranges
 *        that are trimmed according to some condition in the block.
+*
+* The output ranges of predecessors are joined into the input ranges of the
+* @a current block in place. The input ranges of the block are based on the
+* output ranges of its immediate dominator, which dominates the predecessors,
+* too. So, only the memory places stored by the layers between a predecessor
+* and the immediate dominator, by the input layer itself, memory places with
+* trimmed ranges and unstable memory places (see setRange()) are joined. Every
+* other memory place has the same range in the predecessor and in the input
+* ranges, so that joining would not change it.
+*
+* @param[in] current The block whose input ranges are computed.
+* @param[out] changed Memory places whose input ranges have changed.
+*
+* @return @c true if the input ranges of the @a current block have changed.
 */
-void ValueAnalysis::computeInputRanges(const CodeStorage::Block *current)
+bool ValueAnalysis::computeInputRanges(const CodeStorage::Block *current,
+									   RangeLayer::MemoryPlaceSet &changed)
 {
 	// Gets the predecessor of the current block.
 	const TTargetList &preds = current->inbound();
 
-	// Stores the input ranges of the current block, output ranges or trimmed ranges
-	// of its predecessors.
-	MemoryPlaceToRangeMapVector outputOfPreds;
-	outputOfPreds.push_back(ValueAnalysis::getRanges(current, blockToInputRangesMap));
+	RangeLayer &input = blockToRangesMap[current].input;
+	const Block *dominator = blockToDominatorMap[current];
+	const RangeLayer *common = (dominator != NULL) ?
+		&blockToRangesMap[dominator].output : NULL;
+	bool reached = false;
 
 	BOOST_FOREACH(const TTargetList::value_type &pred, preds) {
+		BlockToRangesMap::const_iterator predIt = blockToRangesMap.find(pred);
+		if (predIt == blockToRangesMap.end() ||
+			!predIt->second.output.isValid()) {
+			// The predecessor was not analysed yet, there is nothing to join.
+			continue;
+		}
+
 		// Get the output ranges of the predecessor.
-		MemoryPlaceToRangeMap out = ValueAnalysis::getRanges(pred,
-										blockToOutputRangesMap);
+		const RangeLayer &out = predIt->second.output;
 
-		if (blockToTrimmedRangesMap.find(pred) == blockToTrimmedRangesMap.end()) {
-			// If there are no trimmed ranges, we store the output ranges of
-			// predecessor.
-			outputOfPreds.push_back(out);
-		} else {
-			// If there are trimmed ranges, we have to compute the result from
-			// predecessor's output and trimmed ranges.
-			TrimmedRangesMap trimmed = ValueAnalysis::getTrimmedRanges(pred);
-			MemoryPlaceToRangeMap result
-					= ValueAnalysis::computePartialInputRanges(current, out, trimmed);
-			outputOfPreds.push_back(result);
+		const bool wasReached = input.isValid();
+		if (!wasReached) {
+			input.setValid();
+			reached = true;
 		}
-	}
 
-	// Joins the results of predecessors. It represents the input ranges into
-	// the currently processed block.
-	MemoryPlaceToRangeMap inputToBlock;
-	inputToBlock = ValueAnalysis::join(outputOfPreds);
+		const MemoryPlaceToRangeMap trimmed = getTrimmedRanges(current, pred);
+
+		RangeLayer::MemoryPlaceSet places(unstablePlaces);
+		out.collectPlacesUpTo(common, places);
+		input.collectOwnPlaces(places);
+		BOOST_FOREACH(const MemoryPlaceToRangeMap::value_type &trim, trimmed) {
+			places.insert(trim.first);
+		}
+
+		BOOST_FOREACH(const MemoryPlace *mp, places) {
+			const Range *range = out.find(mp);
+			if (range == NULL) {
+				if (!wasReached) {
+					// The memory place does not come from the predecessor,
+					// so the block has not got it although the dominator has.
+					setRange(input, mp, NULL);
+				}
+				continue;
+			}
+
+			MemoryPlaceToRangeMap::const_iterator trimIt = trimmed.find(mp);
+			if (trimIt != trimmed.end() &&
+				!(intersect(trimIt->second, *range)).empty()) {
+				// If the trimmed range was computed for the current block, we
+				// join the trimmed range instead of the output range.
+				range = &trimIt->second;
+			}
+
+			const Range *old = wasReached ? input.find(mp) : NULL;
+			const Range united = unite((old != NULL) ? *old : Range(), *range);
+			if (old == NULL || !identical(united, *old)) {
+				changed.insert(mp);
+				setRange(input, mp, &united);
+			}
+		}
+	}
 
-	// Assigns the input ranges to the currently processed block.
-	blockToInputRangesMap[current] = inputToBlock;
+	return reached || !changed.empty();
 }
 
 /**
-* @brief Gets the ranges that are changing between @a oldResult and @a newResult
-*        and expands these for faster convergence. Then, these new ranges are
-*        stored for the output of the given @a block.
+* @brief Computes the output ranges of the given @a block from the @a current
+*        ranges at the end of the block.
+*
+* Only the memory places assigned in the block and the memory places stored by
+* the output layer itself can have different ranges in the new and in the old
+* output ranges, all other memory places have the input ranges in both.
+*
+* If the @a block was analysed many times (see @a counter) and its output ranges
+* still change, the changing ranges are expanded for faster convergence.
+*
+* @return @c true if the output ranges of the @a block have changed.
 */
-void ValueAnalysis::expandChangingRanges(const Block* block,
-										 const MemoryPlaceToRangeMap &oldResult,
-										 const MemoryPlaceToRangeMap &newResult)
+bool ValueAnalysis::computeOutputRanges(const Block *block,
+										const CurrentRanges &current,
+										unsigned counter)
 {
+	BlockRanges &ranges = blockToRangesMap[block];
+	RangeLayer &output = ranges.output;
+	const MemoryPlaceToRangeMap &assigned = current.getAssigned();
+
+	if (!output.isValid()) {
+		// The block was not analysed yet, so there were no output ranges.
+		output.setValid();
+		BOOST_FOREACH(const MemoryPlaceToRangeMap::value_type &item, assigned) {
+			setRange(output, item.first, &item.second);
+		}
 
-	MemoryPlaceToRangeMap result;
-	for (MemoryPlaceToRangeMap::const_iterator it = oldResult.begin();
-		 it != oldResult.end(); ++it) {
-
-		const MemoryPlace *key = it->first;
+		return output.size() != 0;
+	}
 
-		// Key must exists in both maps.
-		assert(newResult.find(key) != newResult.end());
+	RangeLayer::MemoryPlaceSet places;
+	output.collectOwnPlaces(places);
+	BOOST_FOREACH(const MemoryPlaceToRangeMap::value_type &item, assigned) {
+		places.insert(item.first);
+	}
 
-		Range oldRange = it->second;
-		MemoryPlaceToRangeMap::const_iterator jt = newResult.find(key);
-		Range newRange = jt->second;
+	std::vector<const Range *> newRanges;
+	bool equal = true;
+	BOOST_FOREACH(const MemoryPlace *mp, places) {
+		MemoryPlaceToRangeMap::const_iterator it = assigned.find(mp);
+		const Range *newRange = (it != assigned.end()) ?
+			&it->second : ranges.input.find(mp);
+		newRanges.push_back(newRange);
+		equal = equal && equalOrMissing(newRange, output.find(mp));
+	}
 
-		if (oldRange == newRange) {
-			// Ranges do not change.
-			result[key] = newRange;
-		} else {
-			// Ranges change after the last processing of the block.
-			result[key] = newRange.expand();
+	if (equal || counter <= ValueAnalysis::NumberOfPassesBeforeExpand) {
+		size_t i = 0;
+		BOOST_FOREACH(const MemoryPlace *mp, places) {
+			setRange(output, mp, newRanges[i++]);
 		}
-	}
 
-	// Firstly, I assumed that the size of oldResult and newResult must be same.
-	// However, this is not true. So, we have to add everything what is in
-	// newResult to result.
-	for (MemoryPlaceToRangeMap::const_iterator it = newResult.begin();
-		 it != newResult.end(); ++it) {
+		return !equal;
+	}
 
-		const MemoryPlace *key = it->first;
-		if (result.find(key) == result.end()) {
-			// If key is not in the result, we have to add it.
-			result[key] = it->second;
+	// If this block was analysed many times and still does
+	// not converge, we will help it a little.
+	bool changed = false;
+	size_t i = 0;
+	BOOST_FOREACH(const MemoryPlace *mp, places) {
+		const Range *newRange = newRanges[i++];
+		const Range *oldRange = output.find(mp);
+		if (oldRange == NULL) {
+			if (newRange != NULL) {
+				changed = true;
+				setRange(output, mp, newRange);
+			}
+			continue;
 		}
+
+		// Key must exists in both ranges.
+		assert(newRange != NULL);
+
+		const Range result = (*oldRange == *newRange) ?
+			// Ranges do not change.
+			*newRange :
+			// Ranges change after the last processing of the block.
+			newRange->expand();
+		changed = changed || !(result == *oldRange);
+		setRange(output, mp, &result);
 	}
 
-	blockToOutputRangesMap[block] = result;
+	expandedBlocks.insert(block);
+
+	return changed;
 }
 
 /**
@@ -396,6 +515,91 @@ bool ValueAnalysis::containOnlyGotoInsn(const Block *block)
 	return false;
 }
 
+/**
+* @brief Computes the immediate dominators of the blocks of the given @a fnc
+*        that are reachable from its entry block.
+*
+* The entry block is mapped to @c NULL, unreachable blocks are not mapped.
+*/
+void ValueAnalysis::computeDominators(const Fnc &fnc)
+{
+	const Block *entryBlock = fnc.cfg.entry();
+
+	// Computes the post-order of the reachable blocks.
+	vector<const Block *> order;
+	std::map<const Block *, size_t> orderOfBlock;
+	std::set<const Block *> visited;
+	vector<pair<const Block *, size_t> > stack;
+	stack.push_back(std::make_pair(entryBlock, 0));
+	visited.insert(entryBlock);
+	while (!stack.empty()) {
+		const Block *block = stack.back().first;
+		const TTargetList &succs = block->targets();
+		const size_t next = stack.back().second++;
+		if (next < succs.size()) {
+			if (visited.insert(succs[next]).second) {
+				stack.push_back(std::make_pair(succs[next], 0));
+			}
+		} else {
+			orderOfBlock[block] = order.size();
+			order.push_back(block);
+			stack.pop_back();
+		}
+	}
+
+	// Iterates over the blocks in the reverse post-order until the dominators
+	// do not change, see "A Simple, Fast Dominance Algorithm" by Cooper et al.
+	BlockToBlockMap dominators;
+	dominators[entryBlock] = entryBlock;
+	bool changed = true;
+	while (changed) {
+		changed = false;
+		for (vector<const Block *>::reverse_iterator it = order.rbegin();
+			 it != order.rend(); ++it) {
+			const Block *block = *it;
+			if (block == entryBlock) {
+				continue;
+			}
+
+			const Block *dominator = NULL;
+			BOOST_FOREACH(const Block *pred, block->inbound()) {
+				if (dominators.find(pred) == dominators.end()) {
+					// Unreachable or not processed predecessor.
+					continue;
+				}
+
+				if (dominator == NULL) {
+					dominator = pred;
+					continue;
+				}
+
+				// Finds the nearest common dominator.
+				const Block *other = pred;
+				while (dominator != other) {
+					while (orderOfBlock[dominator] < orderOfBlock[other]) {
+						dominator = dominators[dominator];
+					}
+					while (orderOfBlock[other] < orderOfBlock[dominator]) {
+						other = dominators[other];
+					}
+				}
+			}
+
+			BlockToBlockMap::iterator domIt = dominators.find(block);
+			if (domIt == dominators.end()) {
+				dominators[block] = dominator;
+				changed = true;
+			} else if (domIt->second != dominator) {
+				domIt->second = dominator;
+				changed = true;
+			}
+		}
+	}
+
+	dominators[entryBlock] = NULL;
+	blockToDominatorMap.insert(dominators.begin(), dominators.end());
+}
+
 /**
 * @brief Computes value-range analysis for the given @a fnc.
 */
@@ -404,7 +608,31 @@ void ValueAnalysis::computeAnalysisForFnc(const Fnc &fnc)
 	const Block *entryBlock = fnc.cfg.entry();
 
 	// Sets the ranges for global variables for the input of the entry block.
-	blockToInputRangesMap[entryBlock] = GlobAnalysis::getGlobVarMap();
+	const MemoryPlaceToRangeMap globVarMap = GlobAnalysis::getGlobVarMap();
+	BOOST_FOREACH(const MemoryPlaceToRangeMap::value_type &g, globVarMap) {
+		if (!isStable(g.second)) {
+			unstablePlaces.insert(g.first);
+		}
+	}
+
+	// Bases the input ranges of every reachable block on the output ranges of
+	// its immediate dominator.
+	ValueAnalysis::computeDominators(fnc);
+	BOOST_FOREACH(const Block *block, fnc.cfg) {
+		BlockToBlockMap::const_iterator domIt = blockToDominatorMap.find(block);
+		if (domIt == blockToDominatorMap.end()) {
+			// The block is unreachable.
+			continue;
+		}
+
+		BlockRanges &ranges = blockToRangesMap[block];
+		if (block == entryBlock) {
+			ranges.input.setRoot(globVarMap);
+		} else {
+			ranges.input.setBase(&blockToRangesMap[domIt->second].output);
+		}
+		ranges.output.setBase(&ranges.input);
+	}
 
 	todoQueue.push(entryBlock);
 	todoSet.insert(entryBlock);
@@ -414,9 +642,6 @@ void ValueAnalysis::computeAnalysisForFnc(const Fnc &fnc)
 		todoQueue.pop();
 		todoSet.erase(block);
 
-		MemoryPlaceToRangeMap oldResult = ValueAnalysis::getRanges(block,
-			blockToOutputRangesMap);
-
 		unsigned long tripCount = LoopFinder::getUpperLimit(block);
 		if ((tripCount != 0) &&
 			(tripCount == ValueAnalysis::tripCountOfBlockMap[block]) ) {
@@ -425,21 +650,10 @@ void ValueAnalysis::computeAnalysisForFnc(const Fnc &fnc)
 			continue;
 		}
 
-		ValueAnalysis::computeAnalysisForBlock(block);
+		const bool changed = ValueAnalysis::computeAnalysisForBlock(block);
 		++ValueAnalysis::tripCountOfBlockMap[block];
-		MemoryPlaceToRangeMap newResult = ValueAnalysis::getRanges(block,
-			blockToOutputRangesMap);
-
-		if (newResult != oldResult) {
-			// If this block was analysed many times and still does
-			// not converge, we will help it a little.
-			if (blockToCounterMap[block] > ValueAnalysis::NumberOfPassesBeforeExpand) {
-				expandChangingRanges(block, oldResult, newResult);
-			}
-		}
 
-		newResult = ValueAnalysis::getRanges(block, blockToOutputRangesMap);
-		if ((newResult != oldResult) || (ValueAnalysis::containOnlyGotoInsn(block))) {
+		if (changed || (ValueAnalysis::containOnlyGotoInsn(block))) {
 			// Gets the successors of the processed block.
 			const TTargetList &succs = block->targets();
 			BOOST_FOREACH(const TTargetList::value_type &succ, succs) {
@@ -451,26 +665,110 @@ void ValueAnalysis::computeAnalysisForFnc(const Fnc &fnc)
 
 /**
 * @brief Computes value-range analysis for the given @a block.
+*
+* The instructions of the block are analysed again only if the input ranges of
+* the block have changed since its last analysis (or if its output ranges were
+* expanded meanwhile). Otherwise, the analysis would give the same output
+* ranges as before.
+*
+* @return @c true if the output ranges of the @a block have changed.
 */
-void ValueAnalysis::computeAnalysisForBlock(const Block *block)
+bool ValueAnalysis::computeAnalysisForBlock(const Block *block)
 {
-	computeInputRanges(block);
+	RangeLayer::MemoryPlaceSet changed;
+	const bool inputChanged = computeInputRanges(block, changed);
 
-	MemoryPlaceToRangeMap outputFromBlock;
-	outputFromBlock = ValueAnalysis::getRanges(block, blockToInputRangesMap);
+	// Increments counter.
+	const unsigned counter = ++blockToCounterMap[block];
 
-	// Starts to analyze the given block.
-	const Insn *prevInsn = NULL;
-	BOOST_FOREACH(const Insn *insn, *block) {
-		ValueAnalysis::computeAnalysisForInsn(insn, prevInsn, outputFromBlock);
-		prevInsn = insn;
+	const BlockRanges &ranges = blockToRangesMap[block];
+	if (ranges.output.isValid() && !inputChanged &&
+		expandedBlocks.find(block) == expandedBlocks.end()) {
+		// Neither the input ranges nor the output ranges changed since the
+		// last analysis of this block, so there is nothing to compute.
+		return false;
 	}
 
+	// Starts to analyze the given block.
+	CurrentRanges current(ranges.input);
+	ValueAnalysis::computeAnalysisForInsns(block, changed, current);
+
+	expandedBlocks.erase(block);
+
 	// Assigns the output ranges to the currently processed block.
-	blockToOutputRangesMap[block] = outputFromBlock;
+	return ValueAnalysis::computeOutputRanges(block, current, counter);
+}
 
-	// Increments counter.
-	++blockToCounterMap[block];
+/**
+* @brief Computes value-range analysis for the instructions of the given
+*        @a block and stores the results in @a output.
+*
+* An instruction is analysed again only if it uses a memory place from
+* @a dirty, which contains the memory places whose ranges may differ from
+* the ranges that the instruction used during the last analysis of the block.
+* Otherwise, the ranges that the instruction assigned last time are assigned
+* again.
+*/
+void ValueAnalysis::computeAnalysisForInsns(const Block *block,
+											RangeLayer::MemoryPlaceSet &dirty,
+											CurrentRanges &output)
+{
+	vector<InsnEffect> &effects = blockToInsnEffectsMap[block];
+	const bool analysed = !effects.empty();
+	effects.resize(block->size());
+
+	const Insn *prevInsn = NULL;
+	for (size_t i = 0; i != block->size(); ++i) {
+		const Insn *insn = (*block)[i];
+		InsnEffect &effect = effects[i];
+
+		bool usesDirty = !analysed;
+		BOOST_FOREACH(const MemoryPlace *mp, effect.reads) {
+			if (usesDirty) {
+				break;
+			}
+			usesDirty = dirty.find(mp) != dirty.end();
+		}
+
+		if (!usesDirty) {
+			// The instruction would assign the same ranges as last time.
+			BOOST_FOREACH(const MemoryPlaceRangePair &item, effect.writes) {
+				output.set(item.first, item.second);
+				dirty.erase(item.first);
+			}
+
+			prevInsn = insn;
+			continue;
+		}
+
+		InsnEffect newEffect;
+		output.record(&newEffect);
+		ValueAnalysis::computeAnalysisForInsn(insn, prevInsn, output);
+		output.record(NULL);
+
+		// Updates the memory places whose ranges may differ from the last
+		// analysis of the block.
+		BOOST_FOREACH(const MemoryPlaceRangePair &item, newEffect.writes) {
+			MemoryPlaceToRangeMap::const_iterator it =
+				effect.writes.find(item.first);
+			if (it != effect.writes.end() &&
+				identical(it->second, item.second)) {
+				dirty.erase(item.first);
+			} else {
+				dirty.insert(item.first);
+			}
+		}
+
+		BOOST_FOREACH(const MemoryPlaceRangePair &item, effect.writes) {
+			if (newEffect.writes.find(item.first) == newEffect.writes.end()) {
+				dirty.insert(item.first);
+			}
+		}
+
+		effect.reads.swap(newEffect.reads);
+		effect.writes.swap(newEffect.writes);
+		prevInsn = insn;
+	}
 }
 
 /**
@@ -478,7 +776,7 @@ void ValueAnalysis::computeAnalysisForBlock(const Block *block)
 *        call instruction. Results are stored in @a output.
 */
 void ValueAnalysis::computeAnalysisForCall(const Insn* insn,
-	MemoryPlaceToRangeMap &output)
+	CurrentRanges &output)
 {
 	const TOperandList &opList = insn->operands;
 	const struct cl_operand &ret = opList[0];   // [0] - destination
@@ -488,7 +786,7 @@ void ValueAnalysis::computeAnalysisForCall(const Insn* insn,
 		// are not stored in the program occurred.
 		const MemoryPlace *retVar = OperandToMemoryPlace::convert(&ret);
 		Range retRange = ValueAnalysis::getRange(ret, output);
-		output[retVar] = retRange;
+		output.set(retVar, retRange);
 	}
 }
 
@@ -497,7 +795,7 @@ void ValueAnalysis::computeAnalysisForCall(const Insn* insn,
 *        joins to @a output.
 */
 void ValueAnalysis::computeAnalysisForInsn(const Insn *insn, const Insn *prevInsn,
-										   MemoryPlaceToRangeMap &output)
+										   CurrentRanges &output)
 {
 	const enum cl_insn_e code = insn->code;
 
@@ -611,7 +909,7 @@ bool ValueAnalysis::evaluateCond(const Range &r1, const Range &r2,
 *        This function is responsible for computing trimmed ranges.
 */
 void ValueAnalysis::computeAnalysisForCond(const Insn *insn, const Insn *prevInsn,
-										   MemoryPlaceToRangeMap &output)
+										   CurrentRanges &output)
 {
 	if (prevInsn == NULL) {
 		// If we do not have previous instruction, we cannot compute trimmed ranges.
@@ -798,7 +1096,7 @@ void ValueAnalysis::computeAnalysisForCond(const Insn *insn, const Insn *prevIns
 *        an unary operation and computed result joins to @a output.
 */
 void ValueAnalysis::computeAnalysisForUnop(const Insn *insn,
-				    					   MemoryPlaceToRangeMap &output)
+				    					   CurrentRanges &output)
 {
 	// There are two operands for unary operations.
 	const TOperandList &opList = insn->operands;
@@ -865,7 +1163,7 @@ void ValueAnalysis::computeAnalysisForUnop(const Insn *insn,
 	}
 
 	// Setting the new range for destination.
-	output[dstVar] = resultRange;
+	output.set(dstVar, resultRange);
 }
 
 /**
@@ -873,7 +1171,7 @@ void ValueAnalysis::computeAnalysisForUnop(const Insn *insn,
 *        a binary operation and computed result joins to @a output.
 */
 void ValueAnalysis::computeAnalysisForBinop(const Insn *insn,
-	 										MemoryPlaceToRangeMap &output)
+	 										CurrentRanges &output)
 {
 	// There are three operands for binary operation.
 	const TOperandList &opList = insn->operands;
@@ -1035,7 +1333,7 @@ void ValueAnalysis::computeAnalysisForBinop(const Insn *insn,
 	}
 
 	// Setting the new range for destination.
-	output[dstVar] = resultRange;
+	output.set(dstVar, resultRange);
 }
 
 /**
@@ -1070,7 +1368,8 @@ ostream& ValueAnalysis::printRanges(ostream &os, const Storage &stor)
 			os << lastLine << ":" << endl;
 
 			// Gets the result of analysis for the currently processed block.
-			MemoryPlaceToRangeMap &blockInfo = blockToInputRangesMap[pBlock];
+			const MemoryPlaceToRangeMap blockInfo =
+				blockToRangesMap[pBlock].input.getRanges();
 			vector<MemoryPlaceRangePair> sortedBlockInfo(
 				blockInfo.begin(), blockInfo.end());
 
@@ -1091,7 +1390,8 @@ ostream& ValueAnalysis::printRanges(ostream &os, const Storage &stor)
 			os << "Block " << block.name() << "[OUT]:" << endl;
 
 			// Gets the result of analysis for the currently processed block.
-			MemoryPlaceToRangeMap &blockInfoOut = blockToOutputRangesMap[pBlock];
+			const MemoryPlaceToRangeMap blockInfoOut =
+				blockToRangesMap[pBlock].output.getRanges();
 			vector<MemoryPlaceRangePair> sortedBlockInfoOut(
 				blockInfoOut.begin(), blockInfoOut.end());
 
@@ -1111,36 +1411,3 @@ ostream& ValueAnalysis::printRanges(ostream &os, const Storage &stor)
 	}
 	return os;
 }
-
-/**
-* @brief Joins data that was gained from the analysis of several blocks.
-*
-* @param[in] vec Data gained from the analysis of several blocks.
-*
-* @return United data from @a vec.
-*
-* Value-range analysis of every block is represented by @c MemoryPlaceToRangeMap
-* that contains all memory places and corresponding ranges for them. During
-* value-range analysis it is necessary to join data of different blocks
-* together. For example, join data of all predecessor blocks that will be
-* used as an input to the next block.
-*/
-ValueAnalysis::MemoryPlaceToRangeMap ValueAnalysis::join(const
-				             MemoryPlaceToRangeMapVector &vec)
-{
-	MemoryPlaceToRangeMap result;
-	if (vec.empty())
-		return result;
-
-	result = vec[0];
-	for (MemoryPlaceToRangeMap::size_type i = 1; i != vec.size(); ++i) {
-		// Iterates over all data that was got from several blocks.
-		BOOST_FOREACH(MemoryPlaceToRangeMap::value_type item, vec[i]) {
-			// Iterates over all memory places.
-			result[item.first] = unite(result[item.first], item.second);
-		}
-	}
-
-	return result;
-}
-
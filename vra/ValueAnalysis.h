@@ -21,6 +21,7 @@
 #include "Range.h"
 #include "MemoryPlace.h"
 #include "LoopFinder.h"
+#include "RangeLayer.h"
 
 /**
 * @brief Class performs the value-range analysis and stores the result.
@@ -87,12 +88,72 @@ class ValueAnalysis {
 		typedef std::map<const CodeStorage::Block*, TrimmedRangesMap>
 			BlockToTrimmedRangesMap;
 
-		/// Type of data stored for several blocks.
-		typedef std::vector<MemoryPlaceToRangeMap> MemoryPlaceToRangeMapVector;
+		/// Type for the input and output ranges of a block. The input ranges
+		/// are based on the output ranges of the immediate dominator of the
+		/// block, the output ranges are based on the input ranges.
+		struct BlockRanges {
+			/// Ranges at the beginning of the block.
+			RangeLayer input;
+
+			/// Ranges at the end of the block.
+			RangeLayer output;
+		};
 
 		/// Type of data stored for the whole analyzed program.
-		typedef std::map<const CodeStorage::Block*, MemoryPlaceToRangeMap>
-			BlockToResultMap;
+		typedef std::map<const CodeStorage::Block*, BlockRanges>
+			BlockToRangesMap;
+
+		/// Type for mapping blocks to their immediate dominators.
+		typedef std::map<const CodeStorage::Block*, const CodeStorage::Block*>
+			BlockToBlockMap;
+
+		/// Type for the memory places read by an instruction and the ranges
+		/// written by it during its last analysis.
+		struct InsnEffect {
+			/// Memory places whose ranges the instruction used.
+			RangeLayer::MemoryPlaceSet reads;
+
+			/// Ranges that the instruction assigned.
+			MemoryPlaceToRangeMap writes;
+		};
+
+		/// Type for the effects of all instructions of a block.
+		typedef std::map<const CodeStorage::Block*, std::vector<InsnEffect> >
+			BlockToInsnEffectsMap;
+
+		/**
+		* @brief Ranges seen by an instruction of the analysed block, which are
+		*        the ranges assigned by the previous instructions of the block
+		*        over the input ranges of the block.
+		*/
+		class CurrentRanges {
+			public:
+				CurrentRanges(const RangeLayer &input):
+					input(input), effect(NULL) {}
+
+				const Range *find(const MemoryPlace *mp);
+				Range get(const MemoryPlace *mp);
+				void set(const MemoryPlace *mp, const Range &range);
+
+				/// Starts (or stops if @a e is @c NULL) recording of the
+				/// effect of an instruction into @a e.
+				void record(InsnEffect *e) { effect = e; }
+
+				/// Returns the ranges assigned in the block so far.
+				const MemoryPlaceToRangeMap &getAssigned() const {
+					return assigned;
+				}
+
+			private:
+				/// Input ranges of the block.
+				const RangeLayer &input;
+
+				/// Ranges assigned in the block so far.
+				MemoryPlaceToRangeMap assigned;
+
+				/// Effect of the instruction being analysed, if recorded.
+				InsnEffect *effect;
+		};
 
 		/// Type for representing scheduler.
 		typedef std::queue<const CodeStorage::Block *> SchedulerQueue;
@@ -106,11 +167,18 @@ class ValueAnalysis {
 		/// Mapping block to the trimmed ranges of this block.
 		static BlockToTrimmedRangesMap blockToTrimmedRangesMap;
 
-		/// Mapping block to the input ranges of this block.
-		static BlockToResultMap blockToInputRangesMap;
+		/// Mapping block to the input and output ranges of this block.
+		static BlockToRangesMap blockToRangesMap;
+
+		/// Mapping block to its immediate dominator.
+		static BlockToBlockMap blockToDominatorMap;
 
-		/// Mapping block to the output ranges of this block.
-		static BlockToResultMap blockToOutputRangesMap;
+		/// Mapping block to the effects of its instructions.
+		static BlockToInsnEffectsMap blockToInsnEffectsMap;
+
+		/// Memory places that had a range that changes when it is joined with
+		/// itself or with an empty range.
+		static RangeLayer::MemoryPlaceSet unstablePlaces;
 
 		/// Block scheduler.
 		static SchedulerQueue todoQueue;
@@ -125,56 +193,62 @@ class ValueAnalysis {
 		/// Stores how many times was the block executed.
 		static BlockToCounterMap blockToCounterMap;
 
-		static void scheduleBlock(const CodeStorage::Block *block);
+		/// Blocks whose output ranges were expanded, so that they differ from
+		/// what the analysis of the block gives for its input ranges.
+		static SchedulerSet expandedBlocks;
 
-		static MemoryPlaceToRangeMap getRanges(const CodeStorage::Block* block,
-											   const BlockToResultMap &inputMap);
+		static void scheduleBlock(const CodeStorage::Block *block);
 
-		static TrimmedRangesMap getTrimmedRanges(const CodeStorage::Block* block);
+		static void computeDominators(const CodeStorage::Fnc &fnc);
 
-		static MemoryPlaceToRangeMap join(const MemoryPlaceToRangeMapVector &vec);
+		static void setRange(RangeLayer &layer, const MemoryPlace *mp,
+							 const Range *range);
 
-		static MemoryPlaceToRangeMap computePartialInputRanges(
+		static MemoryPlaceToRangeMap getTrimmedRanges(
 											const CodeStorage::Block *current,
-											const MemoryPlaceToRangeMap &out,
-											const TrimmedRangesMap &trimmed);
+											const CodeStorage::Block *pred);
+
+		static bool computeInputRanges(const CodeStorage::Block *current,
+									   RangeLayer::MemoryPlaceSet &changed);
 
-		static void computeInputRanges(const CodeStorage::Block *current);
+		static bool computeOutputRanges(const CodeStorage::Block *block,
+										const CurrentRanges &current,
+										unsigned counter);
 
-		static void expandChangingRanges(const CodeStorage::Block *block,
-										 const MemoryPlaceToRangeMap &oldResult,
-										 const MemoryPlaceToRangeMap &newResult);
+		static bool computeAnalysisForBlock(const CodeStorage::Block *block);
 
-		static void computeAnalysisForBlock(const CodeStorage::Block *block);
+		static void computeAnalysisForInsns(const CodeStorage::Block *block,
+											RangeLayer::MemoryPlaceSet &dirty,
+											CurrentRanges &output);
 
 		static void computeAnalysisForInsn(const CodeStorage::Insn *insn,
 										   const CodeStorage::Insn *prevInsn,
-										   MemoryPlaceToRangeMap &output);
+										   CurrentRanges &output);
 
 		static void computeAnalysisForCond(const CodeStorage::Insn *insn,
 										   const CodeStorage::Insn *prevInsn,
-										   MemoryPlaceToRangeMap &output);
+										   CurrentRanges &output);
 
 		static void computeAnalysisForUnop(const CodeStorage::Insn *insn,
-										   MemoryPlaceToRangeMap &output);
+										   CurrentRanges &output);
 
 		static void computeAnalysisForBinop(const CodeStorage::Insn *insn,
-										    MemoryPlaceToRangeMap &output);
+										    CurrentRanges &output);
 
 		static void computeAnalysisForCall(const CodeStorage::Insn* insn,
-										   MemoryPlaceToRangeMap &output);
+										   CurrentRanges &output);
 
 		static Range getRange(const struct cl_operand &src,
-							  MemoryPlaceToRangeMap &output,
+							  CurrentRanges &output,
 							  std::deque<int> indexes = std::deque<int>());
 
 		static void assign(const struct cl_operand &dst, const struct cl_operand &src,
-						   MemoryPlaceToRangeMap &output);
+						   CurrentRanges &output);
 
 		static void assignStructure(const struct cl_type *type,
 									const struct cl_operand &dst,
 									const struct cl_operand &src,
-				    				MemoryPlaceToRangeMap &output,
+				    				CurrentRanges &output,
 									std::deque<int> &indexes);
 
 		static void generateIndexes(const struct cl_type *type,
@@ -183,7 +257,7 @@ class ValueAnalysis {
 
 		static void assignSimpleElement(const struct cl_operand &dst,
 								 		const struct cl_operand &src,
-				 				 		MemoryPlaceToRangeMap &output,
+				 				 		CurrentRanges &output,
 								 		std::deque<int> indDst = std::deque<int>(),
 										std::deque<int> indSrc = std::deque<int>());
 
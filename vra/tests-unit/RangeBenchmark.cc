@@ -0,0 +1,132 @@
+/**
+* @author agent, agent@local
+* @file   RangeBenchmark.cc
+* @brief  Measures the speed of the arithmetic over numbers and ranges.
+*
+* It is not a test, it just emits the time taken by each group of operations,
+* so that changes in the representation of Number and Range can be compared.
+* @date   2026
+*/
+
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+
+#include "Range.h"
+#include "Number.h"
+
+namespace {
+
+typedef Range::Interval Interval;
+
+/// Number of repetitions of each group of operations.
+const int Rounds = 200;
+
+/// Ranges the operations are performed on.
+std::vector<Range> ranges;
+
+Number I(long value)
+{
+	return Number(value, sizeof(int), true);
+}
+
+Number UL(unsigned long value)
+{
+	return Number(value, sizeof(unsigned long), false);
+}
+
+/// Generates ranges with one, two, or three intervals of int values.
+void generateRanges()
+{
+	srand(1);
+	for (int i = 0; i < 64; ++i) {
+		const long lo = rand() % 2001 - 1000;
+		const long hi = lo + rand() % 100;
+		switch (i % 3) {
+			case 0:
+				ranges.push_back(Range(Interval(I(lo), I(hi))));
+				break;
+
+			case 1:
+				ranges.push_back(Range(Interval(I(lo), I(hi)),
+					Interval(I(hi + 10), I(hi + 20))));
+				break;
+
+			default:
+				ranges.push_back(Range(Interval(I(lo), I(lo)),
+					Interval(I(hi), I(hi + 1)), Interval(I(hi + 5), I(INT_MAX))));
+				break;
+		}
+	}
+}
+
+/// Emits the time taken since @a start for the group of operations @a name.
+void report(const char *name, clock_t start, size_t checksum)
+{
+	const double secs = double(clock() - start) / CLOCKS_PER_SEC;
+	printf("%-12s %8.3f s  (%lu)\n", name, secs, (unsigned long) checksum);
+}
+
+template <typename TOp>
+void runBinary(const char *name, TOp op)
+{
+	const clock_t start = clock();
+	size_t checksum = 0;
+	for (int r = 0; r < Rounds; ++r) {
+		for (size_t i = 0; i < ranges.size(); ++i) {
+			const Range &r1 = ranges[i];
+			const Range &r2 = ranges[(i * 7 + r) % ranges.size()];
+			checksum += op(r1, r2).size();
+		}
+	}
+	report(name, start, checksum);
+}
+
+Range add(const Range &r1, const Range &r2)      { return r1 + r2; }
+Range mul(const Range &r1, const Range &r2)      { return r1 * r2; }
+Range bAnd(const Range &r1, const Range &r2)     { return bitAnd(r1, r2); }
+Range join(const Range &r1, const Range &r2)     { return unite(r1, r2); }
+Range meet(const Range &r1, const Range &r2)     { return intersect(r1, r2); }
+
+Range shift(const Range &r1, const Range &)
+{
+	return bitLeftShift(r1, Range(Interval(I(0), I(3))));
+}
+
+Range widen(const Range &r1, const Range &r2)
+{
+	return unite(r1, r2).expand();
+}
+
+void runNumbers()
+{
+	const clock_t start = clock();
+	size_t checksum = 0;
+	for (int r = 0; r < Rounds * 100; ++r) {
+		Number a = I(r - 1000);
+		Number b = UL(ULONG_MAX - r);
+		Number c = a * b + I(r) - (a < b ? a : b);
+		checksum += c.toBool() + (c <= a);
+	}
+	report("numbers", start, checksum);
+}
+
+}
+
+int main()
+{
+	generateRanges();
+
+	runNumbers();
+	runBinary("add", add);
+	runBinary("mul", mul);
+	runBinary("bitAnd", bAnd);
+	runBinary("shift", shift);
+	runBinary("unite", join);
+	runBinary("intersect", meet);
+	runBinary("widen", widen);
+
+	return EXIT_SUCCESS;
+}
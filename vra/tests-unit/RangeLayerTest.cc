@@ -0,0 +1,168 @@
+/**
+* @author agent, agent@local
+* @file   RangeLayerTest.cc
+* @brief  Test class for class RangeLayer.
+* @date   2026
+*/
+
+#include "RangeLayer.h"
+#include "gtest/gtest.h"
+
+using namespace std;
+
+typedef RangeLayer::MemoryPlaceToRangeMap RangeMap;
+
+// Range containing the single int number.
+Range R(int val) { return Range(Number(val, sizeof(int), true)); }
+
+class RangeLayerTest : public ::testing::Test {
+	protected:
+		RangeLayerTest(): a("a", false), b("b", false), c("c", false) {
+		}
+
+		virtual ~RangeLayerTest() {
+		}
+
+		virtual void SetUp() {
+			RangeMap ranges;
+			ranges[&a] = R(1);
+			ranges[&b] = R(2);
+			root.setRoot(ranges);
+			layer.setBase(&root);
+			top.setBase(&layer);
+		}
+
+		virtual void TearDown() {
+		}
+
+		MemoryPlace a, b, c;
+		RangeLayer root, layer, top;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// valid and invalid layers
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(RangeLayerTest,
+InvalidLayerContainsNoRanges)
+{
+	EXPECT_FALSE(layer.isValid());
+	EXPECT_EQ(0u, layer.size());
+	EXPECT_TRUE(layer.find(&a) == NULL);
+	EXPECT_TRUE(layer.getRanges().empty());
+}
+
+TEST_F(RangeLayerTest,
+ValidLayerContainsRangesOfBase)
+{
+	layer.setValid();
+	EXPECT_EQ(2u, layer.size());
+	ASSERT_TRUE(layer.find(&a) != NULL);
+	EXPECT_EQ(R(1), *layer.find(&a));
+	EXPECT_TRUE(layer.find(&c) == NULL);
+	EXPECT_EQ(root.getRanges(), layer.getRanges());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// set()
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(RangeLayerTest,
+SetChangesOnlyTheLayer)
+{
+	layer.setValid();
+	const Range range = R(5);
+	EXPECT_TRUE(layer.set(&a, &range));
+	EXPECT_TRUE(layer.set(&c, &range));
+	EXPECT_EQ(3u, layer.size());
+	EXPECT_EQ(R(5), *layer.find(&a));
+	EXPECT_EQ(R(5), *layer.find(&c));
+	EXPECT_EQ(R(1), *root.find(&a));
+	EXPECT_TRUE(root.find(&c) == NULL);
+}
+
+TEST_F(RangeLayerTest,
+SetOfIdenticalRangeReturnsFalse)
+{
+	layer.setValid();
+	const Range range = R(1);
+	EXPECT_FALSE(layer.set(&a, &range));
+	EXPECT_FALSE(layer.set(&c, NULL));
+}
+
+TEST_F(RangeLayerTest,
+SetOfNullRemovesMemoryPlace)
+{
+	layer.setValid();
+	EXPECT_TRUE(layer.set(&b, NULL));
+	EXPECT_EQ(1u, layer.size());
+	EXPECT_TRUE(layer.find(&b) == NULL);
+	EXPECT_EQ(R(2), *root.find(&b));
+
+	RangeMap expected;
+	expected[&a] = R(1);
+	EXPECT_EQ(expected, layer.getRanges());
+}
+
+TEST_F(RangeLayerTest,
+DependentLayerKeepsPreviousRange)
+{
+	layer.setValid();
+	top.setValid();
+	const Range range = R(7);
+	EXPECT_TRUE(root.set(&a, &range));
+	EXPECT_TRUE(root.set(&c, &range));
+	EXPECT_TRUE(root.set(&b, NULL));
+	EXPECT_EQ(R(7), *root.find(&a));
+
+	// Neither the layer based on the root nor the layer based on it change.
+	EXPECT_EQ(R(1), *layer.find(&a));
+	EXPECT_EQ(R(2), *layer.find(&b));
+	EXPECT_TRUE(layer.find(&c) == NULL);
+	EXPECT_EQ(2u, layer.size());
+	EXPECT_EQ(layer.getRanges(), top.getRanges());
+}
+
+TEST_F(RangeLayerTest,
+InvalidDependentLayerIsNotChanged)
+{
+	layer.setValid();
+	const Range range = R(7);
+	EXPECT_TRUE(layer.set(&a, &range));
+	top.setValid();
+	EXPECT_EQ(R(7), *top.find(&a));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// collectPlacesUpTo()
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(RangeLayerTest,
+CollectedPlacesAreThoseStoredBetweenLayers)
+{
+	layer.setValid();
+	const Range range = R(7);
+	layer.set(&a, &range);
+	top.setValid();
+	top.set(&c, &range);
+
+	RangeLayer::MemoryPlaceSet places;
+	top.collectPlacesUpTo(&layer, places);
+	EXPECT_EQ(1u, places.size());
+	EXPECT_EQ(1u, places.count(&c));
+
+	places.clear();
+	top.collectPlacesUpTo(&root, places);
+	EXPECT_EQ(2u, places.size());
+	EXPECT_EQ(1u, places.count(&a));
+
+	places.clear();
+	top.collectPlacesUpTo(NULL, places);
+	EXPECT_EQ(3u, places.size());
+}
+
+int main(int argc, char *argv[])
+{
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
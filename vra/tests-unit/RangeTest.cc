@@ -6717,6 +6717,199 @@ ComputeRangeForGtOfEmptyRangesWorksCorrectly)
 				 ".*!r1.empty().*!r2.empty().*");
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// identical()
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(RangeTest,
+IdenticalRangesHaveTheSameNumbersOfTheSameType)
+{
+	EXPECT_TRUE(identical(Range(), Range()));
+	EXPECT_TRUE(identical(Range(I<int>(1)), Range(I<int>(1))));
+	EXPECT_FALSE(identical(Range(I<int>(1)), Range(I<long>(1))));
+	EXPECT_FALSE(identical(Range(I<int>(1)), Range(I<unsigned>(1))));
+	EXPECT_FALSE(identical(Range(I<int>(1)),
+						   Range(Interval(I<int>(1), I<int>(2)))));
+}
+
+TEST_F(RangeTest,
+IdenticalFloatRangesAreNotComparedWithEpsilon)
+{
+	EXPECT_TRUE(identical(Range(F<double>(NAN)), Range(F<double>(NAN))));
+	EXPECT_TRUE(identical(Range(F<double>(0.5)), Range(F<double>(0.5))));
+	EXPECT_FALSE(identical(Range(F<double>(0.5)),
+						   Range(F<double>(0.5 + 1e-12))));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// InlineVector
+////////////////////////////////////////////////////////////////////////////////
+
+// Element that counts its live instances, so that leaks and double
+// destructions in InlineVector show up.
+struct Counted {
+	static int live;
+	int value;
+
+	Counted(int v): value(v) { ++live; }
+	Counted(const Counted &c): value(c.value) { ++live; }
+	~Counted() { --live; }
+
+	bool operator==(const Counted &c) const { return value == c.value; }
+};
+
+int Counted::live = 0;
+
+typedef InlineVector<Counted, 2> CountedVector;
+
+// Fills v with the values from, from + 1, ..., from + n - 1.
+void fill(CountedVector &v, int from, int n)
+{
+	for (int i = 0; i < n; ++i) {
+		v.push_back(Counted(from + i));
+	}
+}
+
+// Returns true if v holds exactly the values from, from + 1, ..., from + n - 1.
+bool holds(const CountedVector &v, int from, int n)
+{
+	if (v.size() != static_cast<size_t>(n)) {
+		return false;
+	}
+	for (int i = 0; i < n; ++i) {
+		if (v[i].value != from + i) {
+			return false;
+		}
+	}
+	return true;
+}
+
+TEST_F(RangeTest,
+InlineVectorKeepsElementsWhenGrowingPastInlineCapacity)
+{
+	{
+		CountedVector v;
+		fill(v, 0, 2);
+		EXPECT_TRUE(holds(v, 0, 2));
+
+		fill(v, 2, 15);
+		EXPECT_TRUE(holds(v, 0, 17));
+		EXPECT_EQ(17, Counted::live);
+	}
+	EXPECT_EQ(0, Counted::live);
+}
+
+TEST_F(RangeTest,
+InlineVectorPushBackOfItsOwnElementWorksWhenGrowing)
+{
+	{
+		CountedVector v;
+		fill(v, 7, 2);
+		v.push_back(v.front());
+		v.push_back(v.back());
+		ASSERT_EQ(4U, v.size());
+		EXPECT_EQ(7, v[2].value);
+		EXPECT_EQ(7, v[3].value);
+	}
+	EXPECT_EQ(0, Counted::live);
+}
+
+TEST_F(RangeTest,
+InlineVectorSwapWorksForAllStorageCombinations)
+{
+	{
+		// inline <-> heap
+		CountedVector v1, v2;
+		fill(v1, 0, 1);
+		fill(v2, 10, 5);
+		v1.swap(v2);
+		EXPECT_TRUE(holds(v1, 10, 5));
+		EXPECT_TRUE(holds(v2, 0, 1));
+
+		// heap <-> inline
+		v1.swap(v2);
+		EXPECT_TRUE(holds(v1, 0, 1));
+		EXPECT_TRUE(holds(v2, 10, 5));
+
+		// heap <-> heap
+		CountedVector v3;
+		fill(v3, 20, 3);
+		swap(v2, v3);
+		EXPECT_TRUE(holds(v2, 20, 3));
+		EXPECT_TRUE(holds(v3, 10, 5));
+
+		// inline <-> inline
+		CountedVector v4;
+		fill(v4, 30, 2);
+		swap(v1, v4);
+		EXPECT_TRUE(holds(v1, 30, 2));
+		EXPECT_TRUE(holds(v4, 0, 1));
+
+		// empty <-> heap
+		CountedVector v5;
+		v5.swap(v3);
+		EXPECT_TRUE(holds(v5, 10, 5));
+		EXPECT_TRUE(v3.empty());
+		EXPECT_EQ(11, Counted::live);
+	}
+	EXPECT_EQ(0, Counted::live);
+}
+
+TEST_F(RangeTest,
+InlineVectorSelfAssignmentKeepsElements)
+{
+	{
+		CountedVector v1;
+		fill(v1, 0, 2);
+		CountedVector &r1 = v1;
+		v1 = r1;
+		EXPECT_TRUE(holds(v1, 0, 2));
+
+		CountedVector v2;
+		fill(v2, 0, 9);
+		CountedVector &r2 = v2;
+		v2 = r2;
+		EXPECT_TRUE(holds(v2, 0, 9));
+
+		v2.swap(r2);
+		EXPECT_TRUE(holds(v2, 0, 9));
+		EXPECT_EQ(11, Counted::live);
+	}
+	EXPECT_EQ(0, Counted::live);
+}
+
+TEST_F(RangeTest,
+InlineVectorCopiesOfHeapBackedVectorsAreIndependent)
+{
+	{
+		CountedVector v1;
+		fill(v1, 0, 6);
+
+		CountedVector v2(v1);
+		EXPECT_TRUE(holds(v2, 0, 6));
+		EXPECT_TRUE(v1 == v2);
+		EXPECT_NE(&v1[0], &v2[0]);
+
+		v2.push_back(Counted(6));
+		v2[0].value = 42;
+		EXPECT_TRUE(holds(v1, 0, 6));
+		EXPECT_TRUE(v1 != v2);
+
+		// heap-backed into inline and inline into heap-backed
+		CountedVector v3;
+		fill(v3, 50, 1);
+		v3 = v1;
+		EXPECT_TRUE(holds(v3, 0, 6));
+		v1.clear();
+		fill(v1, 60, 1);
+		v2 = v1;
+		EXPECT_TRUE(holds(v2, 60, 1));
+		EXPECT_TRUE(holds(v3, 0, 6));
+		EXPECT_EQ(8, Counted::live);
+	}
+	EXPECT_EQ(0, Counted::live);
+}
+
 int main(int argc, char *argv[])
 {
 	::testing::InitGoogleTest(&argc, argv);
@@ -12,7 +12,8 @@ echo "Building the unit tests..."
 make
 
 # Run them (show only failures).
-for test in NumberTest RangeTest MemoryPlaceTest OperandToMemoryPlaceTest UtilityTest; do
+for test in NumberTest RangeTest MemoryPlaceTest OperandToMemoryPlaceTest UtilityTest \
+	RangeLayerTest; do
 	echo ""
 	echo "Running $test..."
 	./$test --gtest_color=yes | grep -v "RUN\|OK\|----------\|=========="